@@ -10,10 +10,22 @@ if not exist build\utils mkdir build\utils
 if not exist bin mkdir bin
 if not exist src\constraints mkdir src\constraints
 
+echo Compiling utils modules...
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc -c src/utils/random.cpp -o build/utils/random.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc -c src/utils/mapped_file.cpp -o build/utils/mapped_file.o
+
 echo Compiling core modules...
 g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/data_structures.cpp -o build/core/data_structures.o
 g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/instance_parser.cpp -o build/core/instance_parser.o
 g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/instance.cpp -o build/core/instance.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/compiled_instance.cpp -o build/core/compiled_instance.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/instance_cache.cpp -o build/core/instance_cache.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/instance_profile.cpp -o build/core/instance_profile.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/run_index.cpp -o build/core/run_index.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/schedule_pool.cpp -o build/core/schedule_pool.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/schedule_archive.cpp -o build/core/schedule_archive.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/schedule_symmetry.cpp -o build/core/schedule_symmetry.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c src/core/candidate_lists.cpp -o build/core/candidate_lists.o
 
 echo Compiling constraints modules...
 g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -c src/constraints/hard_constraints.cpp -o build/constraints/hard_constraints.o
@@ -36,31 +48,31 @@ g++ -std=c++17 -Wall -Wextra -O2 -Isrc -c tests/test_initial_solution.cpp -o bui
 g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -c tests/test_main.cpp -o build/tests/test_main.o
 
 echo Linking test runner...
-g++ -std=c++17 -Wall -Wextra -O2 -o bin/test_runner.exe build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/constraints/constraint_evaluator.o build/initial_solution.o build/utils/random.o build/tests/test_runner.o build/tests/test_hard_constraints.o build/tests/test_soft_constraints.o build/tests/test_solution_validator.o build/tests/test_instance10_validator.o build/tests/test_initial_solution.o build/tests/test_main.o
+g++ -std=c++17 -Wall -Wextra -O2 -o bin/test_runner.exe build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/core/run_index.o build/core/schedule_pool.o build/core/schedule_archive.o build/core/schedule_symmetry.o build/core/candidate_lists.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/constraints/constraint_evaluator.o build/neighborhood.o build/initial_solution.o build/utils/random.o build/utils/mapped_file.o build/tests/test_runner.o build/tests/test_hard_constraints.o build/tests/test_soft_constraints.o build/tests/test_solution_validator.o build/tests/test_instance10_validator.o build/tests/test_initial_solution.o build/tests/test_main.o
 
 echo Compiling optimized main...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -o bin/nsp_optimized.exe main_optimized.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o
-
-echo Compiling utils modules...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc -c src/utils/random.cpp -o build/utils/random.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -o bin/nsp_optimized.exe main_optimized.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/utils/mapped_file.o
 
 echo Compiling refactored main...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc -o bin/nsp_refactored.exe main_refactored.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/constraints/constraint_evaluator.o build/neighborhood.o build/initial_solution.o build/simulated_annealing.o build/incremental_evaluator.o build/utils/random.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc -o bin/nsp_refactored.exe main_refactored.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/core/run_index.o build/core/schedule_pool.o build/core/schedule_symmetry.o build/core/candidate_lists.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/constraints/constraint_evaluator.o build/neighborhood.o build/initial_solution.o build/simulated_annealing.o build/incremental_evaluator.o build/utils/random.o build/utils/mapped_file.o
 
 echo Compiling original for comparison...
 g++ -std=c++17 -Wall -Wextra -O2 -o bin/nsp_original.exe main.cpp
 
 echo Compiling hard constraints demo...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/demo_hard_constraints.exe demo_hard_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/demo_hard_constraints.exe demo_hard_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/core/run_index.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/utils/mapped_file.o
 
 echo Compiling Instance1 validation test...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/test_instance1.exe test_instance1_comparison.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/test_instance1.exe test_instance1_comparison.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/core/run_index.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/utils/mapped_file.o
 
 echo Compiling constraint debug tool...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/debug_constraints.exe debug_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -Isrc/constraints -o bin/debug_constraints.exe debug_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/core/run_index.o build/constraints/hard_constraints.o build/constraints/soft_constraints.o build/utils/mapped_file.o
+
+echo Compiling instance profiler...
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc/core -o bin/profile_instance.exe profile_instance.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/utils/mapped_file.o
 
 echo Compiling soft constraints demo...
-g++ -std=c++17 -Wall -Wextra -O2 -Isrc -o bin/demo_soft_constraints.exe demo_soft_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/constraints/soft_constraints.o
+g++ -std=c++17 -Wall -Wextra -O2 -Isrc -o bin/demo_soft_constraints.exe demo_soft_constraints.cpp build/core/data_structures.o build/core/instance_parser.o build/core/instance.o build/core/compiled_instance.o build/core/instance_cache.o build/core/instance_profile.o build/constraints/soft_constraints.o build/utils/mapped_file.o
 
 echo Build complete!
 echo.
@@ -73,3 +85,4 @@ echo   bin/demo_hard_constraints.exe - Demo of HardConstraints class
 echo   bin/test_instance1.exe - Instance1 validation test
 echo   bin/debug_constraints.exe - Debug constraint functions
 echo   bin/demo_soft_constraints.exe - Demo of SoftConstraints class
+echo   bin/profile_instance.exe - Instance metrics and suggested parameters
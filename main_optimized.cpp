@@ -9,6 +9,7 @@
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <cstdlib>
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
@@ -27,7 +28,10 @@ int main(int argc, char* argv[]) {
     
     // Load instance using the new Instance class
     Instance instance;
-    if (!instance.loadFromFile(instance_file)) {
+    // NSP_INSTANCE_CACHE enables the binary instance cache: a directory, or empty to cache next to the file
+    const char* cache_dir = std::getenv("NSP_INSTANCE_CACHE");
+    bool loaded = cache_dir ? instance.loadWithCache(instance_file, cache_dir) : instance.loadFromFile(instance_file);
+    if (!loaded) {
         std::cerr << "Error: Failed to load instance file" << std::endl;
         return 1;
     }
@@ -19,6 +19,7 @@
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <cstdlib>
 
 using namespace std;
 
@@ -27,15 +28,20 @@ string bestSolutionPrint(const Schedule& schedule, const Instance& instance);
 int main(int argc, char **argv) {
     Random::initialize();
     if (argc < 6) {
-        cerr << "Usage: " << argv[0] << " <instance_file> <iterations> <initial_temp> <cooling_rate> <stagnation_limit>" << endl;
+        cerr << "Usage: " << argv[0] << " <instance_file> <iterations> <initial_temp> <cooling_rate> <stagnation_limit> [weight_update_frequency]" << endl;
+        cerr << "  <initial_temp> and <stagnation_limit> may be 'auto' to derive them from the instance profile" << endl;
+        cerr << "  [weight_update_frequency] is in iterations (default: stagnation_limit / 2, 1 = every iteration)" << endl;
         return 1;
     }
     
     string instance_file = "nsp_instancias/instances1_24/" + string(argv[1]);
     int iterations = stoi(argv[2]);
-    double initial_temp = stod(argv[3]);
+    bool auto_temp = string(argv[3]) == "auto";
+    bool auto_stagnation = string(argv[5]) == "auto";
+    double initial_temp = auto_temp ? 0.0 : stod(argv[3]);
     double cooling_rate = stod(argv[4]);
-    int stagnation_limit = stoi(argv[5]);
+    int stagnation_limit = auto_stagnation ? 0 : stoi(argv[5]);
+    int weight_update_frequency = argc > 6 ? stoi(argv[6]) : -1;
     
     cout << "NSP Refactored Version (using Instance and Schedule classes)" << endl;
     cout << "Instance: " << instance_file << endl;
@@ -43,7 +49,10 @@ int main(int argc, char **argv) {
     
     // Load instance using the new Instance class
     Instance instance;
-    if (!instance.loadFromFile(instance_file)) {
+    // NSP_INSTANCE_CACHE enables the binary instance cache: a directory, or empty to cache next to the file
+    const char* cache_dir = getenv("NSP_INSTANCE_CACHE");
+    bool loaded = cache_dir ? instance.loadWithCache(instance_file, cache_dir) : instance.loadFromFile(instance_file);
+    if (!loaded) {
         cerr << "Error: Failed to load instance file" << endl;
         return 1;
     }
@@ -53,13 +62,28 @@ int main(int argc, char **argv) {
     cout << "  Days: " << instance.getHorizonDays() << endl;
     cout << "  Shift types: " << instance.getNumShiftTypes() << endl;
     
+    // Parameters left as 'auto' come from the instance profile
+    InstanceProfile::SuggestedParameters suggested = instance.getProfile().suggestParameters();
+    if (auto_temp) {
+        initial_temp = suggested.initial_temp;
+        cout << "  Initial temperature (auto): " << initial_temp << endl;
+    }
+    if (auto_stagnation) {
+        stagnation_limit = suggested.stagnation_limit;
+        cout << "  Stagnation limit (auto): " << stagnation_limit << endl;
+    }
+    
     time_t start, end;
     
     // Create unified constraint evaluator
     ConstraintEvaluator evaluator(instance);
+    // NSP_CHECK_DELTAS cross-checks every local hard delta against a full evaluation
+    if (getenv("NSP_CHECK_DELTAS")) {
+        evaluator.setDeltaCrossCheck(true);
+    }
 
     // Create and run Simulated Annealing
-    SimulatedAnnealing sa(instance, evaluator, initial_temp, cooling_rate, iterations, stagnation_limit);
+    SimulatedAnnealing sa(instance, evaluator, initial_temp, cooling_rate, iterations, stagnation_limit, weight_update_frequency);
     
     cout << "\n=== PHASE 1: Searching for a feasible solution... ===" << endl;
     time(&start);
@@ -67,7 +91,7 @@ int main(int argc, char **argv) {
     time(&end);
     
     Schedule best_overall_feasible_schedule = best_schedule;
-    double hard_score = evaluator.getHardConstraintViolations(best_overall_feasible_schedule);
+    Score hard_score = evaluator.getHardConstraintViolations(best_overall_feasible_schedule);
 
     if (hard_score < 0) {
         cout << "\nCould not find a feasible solution in Phase 1. The reported solution is the best infeasible one found." << endl;
@@ -84,7 +108,7 @@ int main(int argc, char **argv) {
         debug_outdata << debug_out_line;
         debug_outdata.close();
 
-        SimulatedAnnealing sa_optimizer(instance, evaluator, initial_temp / 10, cooling_rate, iterations, stagnation_limit);
+        SimulatedAnnealing sa_optimizer(instance, evaluator, initial_temp / 10, cooling_rate, iterations, stagnation_limit, weight_update_frequency);
         
         Schedule optimized_schedule = sa_optimizer.solve(best_overall_feasible_schedule, SolveMode::Optimization);
 
@@ -100,7 +124,7 @@ int main(int argc, char **argv) {
     double time_taken = double(end - start);
     
     // Final evaluation
-    double best_score = evaluator.getHardConstraintViolations(best_schedule);
+    Score best_score = evaluator.getHardConstraintViolations(best_schedule);
     int fitness = evaluator.getSoftConstraintViolations(best_schedule);
     
     cout << "\n=== Final Results ===" << endl;
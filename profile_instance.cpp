@@ -0,0 +1,44 @@
+/**
+ * NSP Instance Profiler - prints the structural metrics of one or more instances
+ *
+ * Output is one "name: value" line per metric (see InstanceProfile), so it can
+ * be read by scripts such as run_experiments.py instead of tuning by grid search
+ */
+
+#include "src/core/instance.h"
+#include <iostream>
+#include <cstdlib>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <instance_file> [<instance_file> ...]" << std::endl;
+        std::cerr << "Instance names without a directory are read from nsp_instancias/instances1_24/" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string instance_file = argv[i];
+        if (instance_file.find_first_of("/\\") == std::string::npos) {
+            instance_file = "nsp_instancias/instances1_24/" + instance_file;
+        }
+
+        Instance instance;
+        // NSP_INSTANCE_CACHE enables the binary instance cache: a directory, or empty to cache next to the file
+        const char* cache_dir = std::getenv("NSP_INSTANCE_CACHE");
+        bool loaded = cache_dir ? instance.loadWithCache(instance_file, cache_dir) : instance.loadFromFile(instance_file);
+        if (!loaded) {
+            std::cerr << "Error: Failed to load instance file " << instance_file << std::endl;
+            failures++;
+            continue;
+        }
+
+        std::cout << "instance: " << instance_file << std::endl;
+        instance.getProfile().print(std::cout);
+        if (i + 1 < argc) {
+            std::cout << std::endl;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
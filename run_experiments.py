@@ -9,10 +9,10 @@ def run_experiment(params):
     """
     command = [
         './main_refactored',
-        'nsp_instancias/instances1_24/Instance2.txt',
+        'Instance2.txt',
+        str(params['max_iterations']),
         str(params['initial_temp']),
         str(params['cooling_rate']),
-        str(params['max_iterations']),
         str(params['stagnation_limit'])
     ]
     
@@ -42,10 +42,11 @@ def main():
     Defines the parameter grid and runs experiments.
     """
     param_grid = {
-        'initial_temp': [1000, 5000, 10000],
+        # 'auto' lets the solver derive the value from the instance profile
+        'initial_temp': ['auto', 1000, 5000, 10000],
         'cooling_rate': [0.95, 0.99, 0.995],
         'max_iterations': [10000, 50000, 100000],
-        'stagnation_limit': [500, 1000, 2000]
+        'stagnation_limit': ['auto', 500, 1000, 2000]
     }
     
     # Generate all combinations of parameters
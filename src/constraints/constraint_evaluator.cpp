@@ -1,4 +1,5 @@
 #include "constraint_evaluator.h"
+#include <algorithm>
 #include <iostream>
 
 ConstraintEvaluator::ConstraintEvaluator(const Instance& inst)
@@ -6,8 +7,8 @@ ConstraintEvaluator::ConstraintEvaluator(const Instance& inst)
     initializeDynamicWeights();
 }
 
-double ConstraintEvaluator::getHardConstraintViolations(const Schedule& schedule) {
-    double score = 0;
+Score ConstraintEvaluator::getHardConstraintViolations(const Schedule& schedule) {
+    Score score = 0;
     score += hard_constraints.evaluateMaxShiftsPerType(schedule);
     score += hard_constraints.evaluateWorkingTimeConstraints(schedule);
     score += hard_constraints.evaluateMaxConsecutiveShifts(schedule);
@@ -19,16 +20,12 @@ double ConstraintEvaluator::getHardConstraintViolations(const Schedule& schedule
     return score;
 }
 
-double ConstraintEvaluator::getSoftConstraintViolations(const Schedule& schedule) {
-    double score = 0;
-    score += soft_constraints.evaluateShiftOnRequests(schedule);
-    score += soft_constraints.evaluateShiftOffRequests(schedule);
-    score += soft_constraints.evaluateCoverageRequirements(schedule);
-    return score;
+Score ConstraintEvaluator::getSoftConstraintViolations(const Schedule& schedule) {
+    return soft_constraints.evaluateAll(schedule);
 }
 
-double ConstraintEvaluator::evaluateSchedule(const Schedule& schedule) {
-    double hard_violations = getHardConstraintViolations(schedule);
+Score ConstraintEvaluator::evaluateSchedule(const Schedule& schedule) {
+    Score hard_violations = getHardConstraintViolations(schedule);
     if (hard_violations < 0) {  // Hard constraints violated (negative penalty)
         return hard_violations;
     }
@@ -39,8 +36,8 @@ bool ConstraintEvaluator::isFeasible(const Schedule& schedule) {
     return getHardConstraintViolations(schedule) == 0;
 }
 
-double ConstraintEvaluator::getEmployeeHardConstraintViolations(const Schedule& schedule, int employee_id) {
-    double score = 0;
+Score ConstraintEvaluator::getEmployeeHardConstraintViolations(const ScheduleView& schedule, int employee_id) {
+    Score score = 0;
     score += hard_constraints.evaluateMaxShiftsPerType(schedule, employee_id);
     score += hard_constraints.evaluateWorkingTimeConstraints(schedule, employee_id);
     score += hard_constraints.evaluateMaxConsecutiveShifts(schedule, employee_id);
@@ -52,12 +49,9 @@ double ConstraintEvaluator::getEmployeeHardConstraintViolations(const Schedule&
     return score;
 }
 
-double ConstraintEvaluator::getEmployeeSoftConstraintViolations(const Schedule& schedule, int employee_id) {
-    double score = 0;
-    score += soft_constraints.evaluateShiftOnRequests(schedule, employee_id);
-    score += soft_constraints.evaluateShiftOffRequests(schedule, employee_id);
-    // Coverage requirements are not employee-specific
-    return score;
+Score ConstraintEvaluator::getEmployeeSoftConstraintViolations(const ScheduleView& schedule, int employee_id) {
+    // Shift-on and shift-off requests; coverage requirements are not employee-specific
+    return soft_constraints.evaluateEmployee(schedule, employee_id);
 }
 
 std::vector<std::pair<int, int>> ConstraintEvaluator::getViolatingAssignments(const Schedule& schedule) {
@@ -69,127 +63,83 @@ std::map<std::string, int> ConstraintEvaluator::getHardConstraintViolationsMap(c
 }
 
 void ConstraintEvaluator::initializeDynamicWeights() {
-    // Initialize constraint names mapping
-    constraint_names[HardConstraintType::MAX_ONE_SHIFT_PER_DAY] = "MaxOneShiftPerDay";
-    constraint_names[HardConstraintType::SHIFT_ROTATION] = "ShiftRotation";
-    constraint_names[HardConstraintType::MAX_SHIFTS_PER_TYPE] = "MaxShiftsPerType";
-    constraint_names[HardConstraintType::WORKING_TIME_CONSTRAINTS] = "WorkingTimeConstraints";
-    constraint_names[HardConstraintType::MAX_CONSECUTIVE_SHIFTS] = "MaxConsecutiveShifts";
-    constraint_names[HardConstraintType::MIN_CONSECUTIVE_SHIFTS] = "MinConsecutiveShifts";
-    constraint_names[HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF] = "MinConsecutiveDaysOff";
-    constraint_names[HardConstraintType::MAX_WEEKENDS_WORKED] = "MaxWeekendsWorked";
-    constraint_names[HardConstraintType::PRE_ASSIGNED_DAYS_OFF] = "PreAssignedDaysOff";
+    // Initialize constraint names, indexed like the weights
+    constraint_names[index(HardConstraintType::MAX_ONE_SHIFT_PER_DAY)] = "MaxOneShiftPerDay";
+    constraint_names[index(HardConstraintType::SHIFT_ROTATION)] = "ShiftRotation";
+    constraint_names[index(HardConstraintType::MAX_SHIFTS_PER_TYPE)] = "MaxShiftsPerType";
+    constraint_names[index(HardConstraintType::WORKING_TIME_CONSTRAINTS)] = "WorkingTimeConstraints";
+    constraint_names[index(HardConstraintType::MAX_CONSECUTIVE_SHIFTS)] = "MaxConsecutiveShifts";
+    constraint_names[index(HardConstraintType::MIN_CONSECUTIVE_SHIFTS)] = "MinConsecutiveShifts";
+    constraint_names[index(HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF)] = "MinConsecutiveDaysOff";
+    constraint_names[index(HardConstraintType::MAX_WEEKENDS_WORKED)] = "MaxWeekendsWorked";
+    constraint_names[index(HardConstraintType::PRE_ASSIGNED_DAYS_OFF)] = "PreAssignedDaysOff";
     
     // Initialize all weights to 1.0 (base penalty)
-    for (const auto& pair : constraint_names) {
-        dynamic_weights[pair.first] = 1.0;
-        violation_counts[pair.first] = 0;
-    }
+    resetDynamicWeights();
 }
 
 std::string ConstraintEvaluator::getConstraintName(HardConstraintType type) const {
-    auto it = constraint_names.find(type);
-    return (it != constraint_names.end()) ? it->second : "Unknown";
+    return constraint_names[index(type)];
 }
 
 void ConstraintEvaluator::updateDynamicWeights(const Schedule& schedule) {
-    // Count current violations for each constraint type
-    std::map<HardConstraintType, int> current_violations;
-    
-    // Evaluate each constraint type and count violations
-    current_violations[HardConstraintType::MAX_ONE_SHIFT_PER_DAY] = 
-        (hard_constraints.evaluateMaxOneShiftPerDay(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::SHIFT_ROTATION] = 
-        (hard_constraints.evaluateShiftRotation(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::MAX_SHIFTS_PER_TYPE] = 
-        (hard_constraints.evaluateMaxShiftsPerType(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::WORKING_TIME_CONSTRAINTS] = 
-        (hard_constraints.evaluateWorkingTimeConstraints(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::MAX_CONSECUTIVE_SHIFTS] = 
-        (hard_constraints.evaluateMaxConsecutiveShifts(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::MIN_CONSECUTIVE_SHIFTS] = 
-        (hard_constraints.evaluateMinConsecutiveShifts(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF] = 
-        (hard_constraints.evaluateMinConsecutiveDaysOff(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::MAX_WEEKENDS_WORKED] = 
-        (hard_constraints.evaluateMaxWeekendsWorked(schedule) < 0) ? 1 : 0;
-    current_violations[HardConstraintType::PRE_ASSIGNED_DAYS_OFF] = 
-        (hard_constraints.evaluatePreAssignedDaysOff(schedule) < 0) ? 1 : 0;
-    
-    // Update violation counts and adjust weights
-    const double WEIGHT_INCREASE_FACTOR = 1.3;  // 30% increase for violated constraints
-    const double WEIGHT_DECREASE_FACTOR = 0.95; // 5% decrease for satisfied constraints
-    const double MIN_WEIGHT = 0.1;
-    const double MAX_WEIGHT = 10.0;
+    updateDynamicWeights(hard_constraints.evaluateAllByType(schedule));
+}
+
+void ConstraintEvaluator::updateDynamicWeights(const HardScoreVector& hard_scores) {
+    // Constant time: the per-type scores are kept by IncrementalEvaluator, so this
+    // can run as often as every iteration
+    // Fixed-point weights: x1.3 for violated constraints, x0.95 for satisfied ones,
+    // kept within [0.1, 10]
+    const Score MIN_WEIGHT = ScoreUtils::WEIGHT_SCALE / 10;
+    const Score MAX_WEIGHT = ScoreUtils::WEIGHT_SCALE * 10;
     
-    for (const auto& pair : current_violations) {
-        HardConstraintType constraint_type = pair.first;
-        int violations = pair.second;
-        
-        // Update violation count
-        violation_counts[constraint_type] += violations;
-        
-        // Adjust weight based on current violation status
-        if (violations > 0) {
-            // Increase weight for violated constraints
-            dynamic_weights[constraint_type] = std::min(
-                dynamic_weights[constraint_type] * WEIGHT_INCREASE_FACTOR, 
-                MAX_WEIGHT
-            );
+    for (int type = 0; type < NUM_HARD_CONSTRAINT_TYPES; type++) {
+        // A constraint type counts as violated when its score is negative
+        if (hard_scores.values[type] < 0) {
+            violation_counts[type]++;
+            dynamic_weights[type] = std::min(dynamic_weights[type] * 13 / 10, MAX_WEIGHT);
         } else {
             // Slightly decrease weight for satisfied constraints
-            dynamic_weights[constraint_type] = std::max(
-                dynamic_weights[constraint_type] * WEIGHT_DECREASE_FACTOR, 
-                MIN_WEIGHT
-            );
+            dynamic_weights[type] = std::max(dynamic_weights[type] * 19 / 20, MIN_WEIGHT);
         }
     }
 }
 
 void ConstraintEvaluator::resetDynamicWeights() {
-    for (auto& pair : dynamic_weights) {
-        pair.second = 1.0;
-    }
-    for (auto& pair : violation_counts) {
-        pair.second = 0;
-    }
+    dynamic_weights.fill(ScoreUtils::WEIGHT_SCALE);
+    violation_counts.fill(0);
 }
 
 double ConstraintEvaluator::getDynamicWeight(HardConstraintType type) const {
-    auto it = dynamic_weights.find(type);
-    return (it != dynamic_weights.end()) ? it->second : 1.0;
+    return ScoreUtils::unscaleWeighted(dynamic_weights[index(type)]);
 }
 
 std::map<HardConstraintType, double> ConstraintEvaluator::getDynamicWeights() const {
-    return dynamic_weights;
+    std::map<HardConstraintType, double> weights;
+    for (int type = 0; type < NUM_HARD_CONSTRAINT_TYPES; type++) {
+        weights[static_cast<HardConstraintType>(type)] = ScoreUtils::unscaleWeighted(dynamic_weights[type]);
+    }
+    return weights;
 }
 
 std::map<HardConstraintType, int> ConstraintEvaluator::getViolationCounts() const {
-    return violation_counts;
+    std::map<HardConstraintType, int> counts;
+    for (int type = 0; type < NUM_HARD_CONSTRAINT_TYPES; type++) {
+        counts[static_cast<HardConstraintType>(type)] = violation_counts[type];
+    }
+    return counts;
 }
 
-double ConstraintEvaluator::getWeightedHardConstraintViolations(const Schedule& schedule) {
-    double weighted_score = 0;
-    
+Score ConstraintEvaluator::getWeightedHardConstraintViolations(const Schedule& schedule) {
+    return getWeightedHardScore(hard_constraints.evaluateAllByType(schedule));
+}
+
+Score ConstraintEvaluator::getWeightedHardScore(const HardScoreVector& hard_scores) const {
     // Apply dynamic weights to each constraint type
-    weighted_score += getDynamicWeight(HardConstraintType::MAX_ONE_SHIFT_PER_DAY) * 
-                     hard_constraints.evaluateMaxOneShiftPerDay(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::SHIFT_ROTATION) * 
-                     hard_constraints.evaluateShiftRotation(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::MAX_SHIFTS_PER_TYPE) * 
-                     hard_constraints.evaluateMaxShiftsPerType(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::WORKING_TIME_CONSTRAINTS) * 
-                     hard_constraints.evaluateWorkingTimeConstraints(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::MAX_CONSECUTIVE_SHIFTS) * 
-                     hard_constraints.evaluateMaxConsecutiveShifts(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::MIN_CONSECUTIVE_SHIFTS) * 
-                     hard_constraints.evaluateMinConsecutiveShifts(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF) * 
-                     hard_constraints.evaluateMinConsecutiveDaysOff(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::MAX_WEEKENDS_WORKED) * 
-                     hard_constraints.evaluateMaxWeekendsWorked(schedule);
-    weighted_score += getDynamicWeight(HardConstraintType::PRE_ASSIGNED_DAYS_OFF) * 
-                     hard_constraints.evaluatePreAssignedDaysOff(schedule);
-    
+    Score weighted_score = 0;
+    for (int type = 0; type < NUM_HARD_CONSTRAINT_TYPES; type++) {
+        weighted_score += dynamic_weights[type] * hard_scores.values[type];
+    }
     return weighted_score;
 }
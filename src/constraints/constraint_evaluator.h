@@ -5,21 +5,10 @@
 #include "../core/data_structures.h"
 #include "hard_constraints.h"
 #include "soft_constraints.h"
+#include <array>
 #include <map>
 #include <string>
 
-enum class HardConstraintType {
-    MAX_ONE_SHIFT_PER_DAY,
-    SHIFT_ROTATION,
-    MAX_SHIFTS_PER_TYPE,
-    WORKING_TIME_CONSTRAINTS,
-    MAX_CONSECUTIVE_SHIFTS,
-    MIN_CONSECUTIVE_SHIFTS,
-    MIN_CONSECUTIVE_DAYS_OFF,
-    MAX_WEEKENDS_WORKED,
-    PRE_ASSIGNED_DAYS_OFF
-};
-
 class ConstraintEvaluator {
 public:
     const Instance& instance;
@@ -27,34 +16,47 @@ public:
     SoftConstraints soft_constraints;
 
 private:
-    // Dynamic penalty weights for adaptive constraint handling
-    std::map<HardConstraintType, double> dynamic_weights;
-    std::map<HardConstraintType, int> violation_counts;
-    std::map<HardConstraintType, std::string> constraint_names;
+    // Dynamic penalty weights for adaptive constraint handling, indexed by HardConstraintType,
+    // in fixed point (units of 1/ScoreUtils::WEIGHT_SCALE)
+    std::array<Score, NUM_HARD_CONSTRAINT_TYPES> dynamic_weights;
+    std::array<int, NUM_HARD_CONSTRAINT_TYPES> violation_counts;  // Weight updates that found the type violated
+    std::array<std::string, NUM_HARD_CONSTRAINT_TYPES> constraint_names;
     
+    static size_t index(HardConstraintType type) { return static_cast<size_t>(type); }
     void initializeDynamicWeights();
     std::string getConstraintName(HardConstraintType type) const;
 
 public:
     ConstraintEvaluator(const Instance& inst);
-    double evaluateSchedule(const Schedule& schedule);
+    Score evaluateSchedule(const Schedule& schedule);
     bool isFeasible(const Schedule& schedule);
-    double getHardConstraintViolations(const Schedule& schedule);
-    double getSoftConstraintViolations(const Schedule& schedule);
-    double getEmployeeHardConstraintViolations(const Schedule& schedule, int employee_id);
-    double getEmployeeSoftConstraintViolations(const Schedule& schedule, int employee_id);
+    Score getHardConstraintViolations(const Schedule& schedule);
+    Score getSoftConstraintViolations(const Schedule& schedule);
+    Score getEmployeeHardConstraintViolations(const ScheduleView& schedule, int employee_id);
+    Score getEmployeeSoftConstraintViolations(const ScheduleView& schedule, int employee_id);
     std::vector<std::pair<int, int>> getViolatingAssignments(const Schedule& schedule);
     std::map<std::string, int> getHardConstraintViolationsMap(const Schedule& schedule);
     
+    // Skips the pre-assigned days off constraint while moves keep frozen cells empty
+    void setFrozenCellsEnforced(bool enforced) { hard_constraints.setFrozenCellsEnforced(enforced); }
+    bool areFrozenCellsEnforced() const { return hard_constraints.areFrozenCellsEnforced(); }
+    
+    // Verifies every local hard delta against a full row evaluation (slow, for debugging)
+    void setDeltaCrossCheck(bool enabled) { hard_constraints.setDeltaCrossCheck(enabled); }
+    
     // Dynamic weight management methods
     void updateDynamicWeights(const Schedule& schedule);
+    void updateDynamicWeights(const HardScoreVector& hard_scores);
     void resetDynamicWeights();
-    double getDynamicWeight(HardConstraintType type) const;
+    double getDynamicWeight(HardConstraintType type) const;  // In natural units
+    // Copies keyed by type in natural units, for reporting
     std::map<HardConstraintType, double> getDynamicWeights() const;
     std::map<HardConstraintType, int> getViolationCounts() const;
     
-    // Enhanced evaluation with dynamic weights
-    double getWeightedHardConstraintViolations(const Schedule& schedule);
+    // Enhanced evaluation with dynamic weights, in fixed point (see ScoreUtils::unscaleWeighted)
+    Score getWeightedHardConstraintViolations(const Schedule& schedule);
+    // Dot product of a per-type hard score (or delta) with the dynamic weights, in fixed point
+    Score getWeightedHardScore(const HardScoreVector& hard_scores) const;
 };
 
 #endif // CONSTRAINT_EVALUATOR_H
@@ -1,72 +1,84 @@
 #include "hard_constraints.h"
+#include "../utils/bit_utils.h"
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 #include <map>
 #include <vector>
 
-HardConstraints::HardConstraints(const Instance& inst) : instance(inst) {}
+HardConstraints::HardConstraints(const Instance& inst) 
+    : instance(inst), compiled(inst.getCompiled()), weekend_mask(buildWeekendMask(inst.getHorizonDays())),
+      shift_count_scratch(inst.getNumShiftTypes() + 1, 0),
+      frozen_cells_enforced(false), delta_cross_check(false) {}
 
 // Helper methods
 
 bool HardConstraints::isValidShiftTransition(int current_shift, int next_shift) const {
-    if (current_shift == 0 || next_shift == 0) {
-        return true; // No restriction if either is a day off
-    }
-    
-    const Shift& current_shift_info = instance.getShift(current_shift - 1);
+    // Day off rows and bits are never set, so no special case is needed
+    return !compiled.isForbiddenTransition(current_shift, next_shift);
+}
+
+std::vector<uint64_t> HardConstraints::buildWeekendMask(int horizon) {
+    std::vector<uint64_t> mask(BitUtils::wordsFor(horizon), 0);
     
-    // Check if next shift is in the "can't follow" list
-    for (const auto& cant_follow : current_shift_info.cant_follow) {
-        if (cant_follow.compare("\n") != 3) {
-            const Shift& next_shift_info = instance.getShift(next_shift - 1);
-            if (next_shift_info.ShiftID[0] == cant_follow[0]) {
-                return false;
-            }
-        }
+    // Weekends start on Saturday=5 (Sunday=6) in 0-based indexing and need both days in the horizon
+    for (int weekend_start = 5; weekend_start + 1 < horizon; weekend_start += 7) {
+        BitUtils::setBit(mask.data(), weekend_start);
     }
-    return true;
+    return mask;
 }
 
-int HardConstraints::countConsecutiveWork(const Schedule& schedule, int employee, int start_day) const {
-    int count = 0;
-    int horizon = schedule.getHorizonDays();
-    
-    for (int day = start_day; day < horizon; day++) {
-        if (schedule.getAssignment(employee, day) != 0) {
-            count++;
-        } else {
-            break;
+const uint64_t* HardConstraints::workBits(const ScheduleView& schedule, int employee) const {
+    return schedule.getWorkBits(employee, work_scratch);
+}
+
+void HardConstraints::addRunPenalty(HardScoreVector& scores, const CompiledInstance::EmployeeLimits& limits,
+                                    int length, bool working, int sign) const {
+    // Same penalties as evaluateMaxConsecutiveShifts, evaluateMinConsecutiveShifts
+    // and evaluateMinConsecutiveDaysOff charge for a single run, added 'sign' times
+    if (working) {
+        if (length > limits.max_consecutive_shifts) {
+            scores[HardConstraintType::MAX_CONSECUTIVE_SHIFTS] -= sign * 10 * (length - limits.max_consecutive_shifts);
         }
+        if (length < limits.min_consecutive_shifts) {
+            scores[HardConstraintType::MIN_CONSECUTIVE_SHIFTS] -= sign * 50;
+        }
+    } else if (length < limits.min_consecutive_days_off) {
+        scores[HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF] -= sign * 60;
     }
-    return count;
 }
 
-int HardConstraints::countConsecutiveDaysOff(const Schedule& schedule, int employee, int start_day) const {
-    int count = 0;
+int HardConstraints::countConsecutiveWork(const ScheduleView& schedule, int employee, int start_day) const {
     int horizon = schedule.getHorizonDays();
-    
-    for (int day = start_day; day < horizon; day++) {
-        if (schedule.getAssignment(employee, day) == 0) {
-            count++;
-        } else {
-            break;
-        }
-    }
-    return count;
+    if (start_day < 0 || start_day >= horizon) return 0;
+    return BitUtils::nextClearBit(workBits(schedule, employee), start_day, horizon) - start_day;
 }
 
-int HardConstraints::countWeekendsWorked(const Schedule& schedule, int employee) const {
-    int weekend_count = 0;
+int HardConstraints::countConsecutiveDaysOff(const ScheduleView& schedule, int employee, int start_day) const {
     int horizon = schedule.getHorizonDays();
+    if (start_day < 0 || start_day >= horizon) return 0;
+    return BitUtils::nextSetBit(workBits(schedule, employee), start_day, horizon) - start_day;
+}
+
+int HardConstraints::countWeekendsWorked(const ScheduleView& schedule, int employee) const {
+    int horizon = schedule.getHorizonDays();
+    std::vector<uint64_t> other_mask;
+    const std::vector<uint64_t>* mask = &weekend_mask;
+    if (horizon != instance.getHorizonDays()) {
+        other_mask = buildWeekendMask(horizon);
+        mask = &other_mask;
+    }
     
-    // Check weekends (assuming Saturday=5, Sunday=6 in 0-based indexing)
-    for (int weekend_start = 5; weekend_start < horizon; weekend_start += 7) {
-        if (weekend_start + 1 < horizon) {
-            if (schedule.getAssignment(employee, weekend_start) != 0 || 
-                schedule.getAssignment(employee, weekend_start + 1) != 0) {
-                weekend_count++;
-            }
+    // A weekend is worked when Saturday or Sunday is: fold each Sunday bit onto its Saturday
+    const uint64_t* bits = workBits(schedule, employee);
+    int words = static_cast<int>(mask->size());
+    int weekend_count = 0;
+    for (int i = 0; i < words; i++) {
+        uint64_t next_day = bits[i] >> 1;
+        if (i + 1 < words) {
+            next_day |= bits[i + 1] << (BitUtils::WORD_BITS - 1);
         }
+        weekend_count += BitUtils::popcount((bits[i] | next_day) & (*mask)[i]);
     }
     return weekend_count;
 }
@@ -88,7 +100,7 @@ int HardConstraints::evaluateShiftRotation(const Schedule& schedule) const {
     return penalty;
 }
 
-int HardConstraints::evaluateShiftRotation(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateShiftRotation(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
     int horizon = schedule.getHorizonDays();
     for (int day = 0; day < horizon - 1; day++) {
@@ -111,22 +123,17 @@ int HardConstraints::evaluateMaxShiftsPerType(const Schedule& schedule) const {
     return penalty;
 }
 
-int HardConstraints::evaluateMaxShiftsPerType(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateMaxShiftsPerType(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
     int num_shifts = instance.getNumShiftTypes();
-    const Staff& worker = instance.getStaff(employee_id);
     
     for (int shift_type = 1; shift_type <= num_shifts; shift_type++) {
         int shift_count = schedule.getShiftCount(employee_id, shift_type);
         
-        // Check max shifts constraint
-        if (shift_type - 1 < static_cast<int>(worker.MaxShifts.size())) {
-            if (worker.MaxShifts[shift_type - 1] != "None") {
-                int max_shifts = std::stoi(worker.MaxShifts[shift_type - 1]);
-                if (shift_count > max_shifts) {
-                    penalty -= 10 * (shift_count - max_shifts);
-                }
-            }
+        // Check max shifts constraint ("None" compiles to NO_LIMIT)
+        int max_shifts = compiled.getMaxShifts(employee_id, shift_type);
+        if (shift_count > max_shifts) {
+            penalty -= 10 * (shift_count - max_shifts);
         }
     }
     return penalty;
@@ -141,23 +148,20 @@ int HardConstraints::evaluateWorkingTimeConstraints(const Schedule& schedule) co
     return penalty;
 }
 
-int HardConstraints::evaluateWorkingTimeConstraints(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateWorkingTimeConstraints(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
-    const Staff& worker = instance.getStaff(employee_id);
-    int total_minutes = 0;
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
     
-    // Calculate total minutes worked
-    for (int shift_type = 1; shift_type <= instance.getNumShiftTypes(); shift_type++) {
-        int shift_count = schedule.getShiftCount(employee_id, shift_type);
-        const Shift& shift_info = instance.getShift(shift_type - 1);
-        total_minutes += shift_count * shift_info.mins;
-    }
+    // Total minutes worked: maintained counter when the schedule tracks it, else from shift counts
+    int total_minutes = schedule.tracksMinutes() ?
+        schedule.getTotalMinutes(employee_id) :
+        schedule.getTotalMinutes(employee_id, instance.getShiftDurations());
     
     // Check min/max total minutes constraints
-    if (total_minutes > worker.MaxTotalMinutes) {
+    if (total_minutes > limits.max_total_minutes) {
         penalty -= 10;
     }
-    if (total_minutes < worker.MinTotalMinutes) {
+    if (total_minutes < limits.min_total_minutes) {
         penalty -= 10;
     }
     return penalty;
@@ -172,21 +176,19 @@ int HardConstraints::evaluateMaxConsecutiveShifts(const Schedule& schedule) cons
     return penalty;
 }
 
-int HardConstraints::evaluateMaxConsecutiveShifts(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateMaxConsecutiveShifts(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
     int horizon = schedule.getHorizonDays();
-    const Staff& worker = instance.getStaff(employee_id);
-    int consecutive_count = 0;
-    
-    for (int day = 0; day < horizon; day++) {
-        if (schedule.getAssignment(employee_id, day) != 0) {
-            consecutive_count++;
-            if (consecutive_count > worker.MaxConsecutiveShifts) {
-                penalty -= 10;
-            }
-        } else {
-            consecutive_count = 0;
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    const uint64_t* bits = workBits(schedule, employee_id);
+    
+    // Every day of a work run beyond the maximum costs one penalty unit
+    for (int start = BitUtils::nextSetBit(bits, 0, horizon); start < horizon; ) {
+        int end = BitUtils::nextClearBit(bits, start, horizon);
+        if (end - start > limits.max_consecutive_shifts) {
+            penalty -= 10 * (end - start - limits.max_consecutive_shifts);
         }
+        start = BitUtils::nextSetBit(bits, end, horizon);
     }
     return penalty;
 }
@@ -200,34 +202,19 @@ int HardConstraints::evaluateMinConsecutiveShifts(const Schedule& schedule) cons
     return penalty;
 }
 
-int HardConstraints::evaluateMinConsecutiveShifts(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateMinConsecutiveShifts(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
     int horizon = schedule.getHorizonDays();
-    const Staff& worker = instance.getStaff(employee_id);
-    bool in_work_period = false;
-    int work_period_length = 0;
-    
-    for (int day = 0; day < horizon; day++) {
-        if (schedule.getAssignment(employee_id, day) != 0) {
-            if (!in_work_period) {
-                in_work_period = true;
-            }
-            work_period_length++;
-        } else {
-            if (in_work_period) {
-                // End of work period, check if it meets minimum
-                if (work_period_length < worker.MinConsecutiveShifts) {
-                    penalty -= 50;
-                }
-                in_work_period = false;
-            }
-            work_period_length = 0;
-        }
-    }
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    const uint64_t* bits = workBits(schedule, employee_id);
     
-    // Check final work period
-    if (in_work_period && work_period_length < worker.MinConsecutiveShifts) {
-        penalty -= 50;
+    // Each work period shorter than the minimum, including one running to the horizon end
+    for (int start = BitUtils::nextSetBit(bits, 0, horizon); start < horizon; ) {
+        int end = BitUtils::nextClearBit(bits, start, horizon);
+        if (end - start < limits.min_consecutive_shifts) {
+            penalty -= 50;
+        }
+        start = BitUtils::nextSetBit(bits, end, horizon);
     }
     return penalty;
 }
@@ -241,31 +228,19 @@ int HardConstraints::evaluateMinConsecutiveDaysOff(const Schedule& schedule) con
     return penalty;
 }
 
-int HardConstraints::evaluateMinConsecutiveDaysOff(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateMinConsecutiveDaysOff(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
     int horizon = schedule.getHorizonDays();
-    const Staff& worker = instance.getStaff(employee_id);
-    int consecutive_off_count = 0;
-    bool in_off_period = false;
-
-    for (int day = 0; day < horizon; ++day) {
-        if (schedule.getAssignment(employee_id, day) == 0) {
-            if (!in_off_period) {
-                in_off_period = true;
-            }
-            consecutive_off_count++;
-        } else {
-            if (in_off_period) {
-                if (consecutive_off_count < worker.MinConsecutiveDaysOff) {
-                    penalty -= 60;
-                }
-                in_off_period = false;
-            }
-            consecutive_off_count = 0;
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    const uint64_t* bits = workBits(schedule, employee_id);
+
+    // Each off period shorter than the minimum, including leading and trailing ones
+    for (int start = BitUtils::nextClearBit(bits, 0, horizon); start < horizon; ) {
+        int end = BitUtils::nextSetBit(bits, start, horizon);
+        if (end - start < limits.min_consecutive_days_off) {
+            penalty -= 60;
         }
-    }
-    if (in_off_period && consecutive_off_count < worker.MinConsecutiveDaysOff) {
-        penalty -= 60;
+        start = BitUtils::nextClearBit(bits, end, horizon);
     }
     return penalty;
 }
@@ -279,18 +254,19 @@ int HardConstraints::evaluateMaxWeekendsWorked(const Schedule& schedule) const {
     return penalty;
 }
 
-int HardConstraints::evaluateMaxWeekendsWorked(const Schedule& schedule, int employee_id) const {
+int HardConstraints::evaluateMaxWeekendsWorked(const ScheduleView& schedule, int employee_id) const {
     int penalty = 0;
-    const Staff& worker = instance.getStaff(employee_id);
+    int max_weekends = compiled.getLimits(employee_id).max_weekends;
     int weekend_count = countWeekendsWorked(schedule, employee_id);
     
-    if (weekend_count > worker.MaxWeekends) {
-        penalty -= 100 * (weekend_count - worker.MaxWeekends);
+    if (weekend_count > max_weekends) {
+        penalty -= 100 * (weekend_count - max_weekends);
     }
     return penalty;
 }
 
 int HardConstraints::evaluatePreAssignedDaysOff(const Schedule& schedule) const {
+    if (frozen_cells_enforced) return 0;
     int penalty = 0;
     int num_employees = schedule.getNumEmployees();
     for (int emp = 0; emp < num_employees; emp++) {
@@ -299,27 +275,18 @@ int HardConstraints::evaluatePreAssignedDaysOff(const Schedule& schedule) const
     return penalty;
 }
 
-int HardConstraints::evaluatePreAssignedDaysOff(const Schedule& schedule, int employee_id) const {
-    int penalty = 0;
-    int horizon = schedule.getHorizonDays();
-    const auto& days_off_list = instance.getDaysOff();
-    const Staff& worker = instance.getStaff(employee_id);
-    
-    // Find days off for this employee
-    for (const auto& days_off : days_off_list) {
-        if (days_off.EmployeeID == worker.ID) {
-            for (const auto& day_str : days_off.DayIndexes) {
-                int day_index = std::stoi(day_str);
-                if (day_index >= 0 && day_index < horizon) {
-                    if (schedule.getAssignment(employee_id, day_index) != 0) {
-                        penalty -= 1000; // Very high penalty for violating mandatory days off
-                    }
-                }
-            }
-            break;
-        }
-    }
-    return penalty;
+int HardConstraints::evaluatePreAssignedDaysOff(const ScheduleView& schedule, int employee_id) const {
+    if (frozen_cells_enforced) return 0;
+    
+    // Every worked day that is a mandatory day off costs 1000
+    const uint64_t* bits = workBits(schedule, employee_id);
+    const uint64_t* days_off = compiled.getDaysOffBits(employee_id);
+    int words = std::min(schedule.getWorkWords(), compiled.getDaysOffWords());
+    int worked_days_off = 0;
+    for (int i = 0; i < words; i++) {
+        worked_days_off += BitUtils::popcount(bits[i] & days_off[i]);
+    }
+    return -1000 * worked_days_off;
 }
 
 // Aggregate evaluation methods
@@ -343,7 +310,7 @@ bool HardConstraints::isFeasible(const Schedule& schedule) const {
     return evaluateAll(schedule) == 0;
 }
 
-int HardConstraints::evaluateEmployee(const Schedule& schedule, int employee) const {
+int HardConstraints::evaluateEmployee(const ScheduleView& schedule, int employee) const {
     int total_penalty = 0;
     total_penalty += evaluateShiftRotation(schedule, employee);
     total_penalty += evaluateMaxShiftsPerType(schedule, employee);
@@ -356,6 +323,27 @@ int HardConstraints::evaluateEmployee(const Schedule& schedule, int employee) co
     return total_penalty;
 }
 
+HardScoreVector HardConstraints::evaluateEmployeeByType(const ScheduleView& schedule, int employee) const {
+    HardScoreVector scores;
+    scores[HardConstraintType::SHIFT_ROTATION] = evaluateShiftRotation(schedule, employee);
+    scores[HardConstraintType::MAX_SHIFTS_PER_TYPE] = evaluateMaxShiftsPerType(schedule, employee);
+    scores[HardConstraintType::WORKING_TIME_CONSTRAINTS] = evaluateWorkingTimeConstraints(schedule, employee);
+    scores[HardConstraintType::MAX_CONSECUTIVE_SHIFTS] = evaluateMaxConsecutiveShifts(schedule, employee);
+    scores[HardConstraintType::MIN_CONSECUTIVE_SHIFTS] = evaluateMinConsecutiveShifts(schedule, employee);
+    scores[HardConstraintType::MIN_CONSECUTIVE_DAYS_OFF] = evaluateMinConsecutiveDaysOff(schedule, employee);
+    scores[HardConstraintType::MAX_WEEKENDS_WORKED] = evaluateMaxWeekendsWorked(schedule, employee);
+    scores[HardConstraintType::PRE_ASSIGNED_DAYS_OFF] = evaluatePreAssignedDaysOff(schedule, employee);
+    return scores;
+}
+
+HardScoreVector HardConstraints::evaluateAllByType(const Schedule& schedule) const {
+    HardScoreVector scores;
+    for (int emp = 0; emp < schedule.getNumEmployees(); emp++) {
+        scores += evaluateEmployeeByType(schedule, emp);
+    }
+    return scores;
+}
+
 int HardConstraints::evaluateMove(const Schedule& schedule, int employee, int day, 
                                   int old_shift, int new_shift) const {
     // Create a copy of the schedule with the proposed move
@@ -503,13 +491,12 @@ std::map<std::string, int> HardConstraints::getConstraintViolations(const Schedu
 
 // Incremental evaluation methods
 
-int HardConstraints::calculateEmployeeDelta(const Schedule& schedule, int employee_id, int day, int new_shift) const {
+int HardConstraints::calculateEmployeeDelta(const ScheduleView& schedule, int employee_id, int day, int new_shift) const {
     // 1. Guarda la puntuación actual de las restricciones duras para este empleado
     int old_score = evaluateEmployee(schedule, employee_id);
     
-    // 2. Crea una copia temporal del horario para simular el cambio de forma segura
-    //    Esta es la única copia temporal que permitiremos, y su alcance es muy limitado.
-    Schedule temp_schedule = schedule;
+    // 2. Simula el cambio con una vista parcheada: sin copiar el horario ni reservar memoria
+    ScheduleView temp_schedule = schedule;
     temp_schedule.setAssignment(employee_id, day, new_shift);
     
     // 3. Calcula la nueva puntuación del empleado en el horario simulado
@@ -518,3 +505,330 @@ int HardConstraints::calculateEmployeeDelta(const Schedule& schedule, int employ
     // 4. Devuelve la diferencia. Esto nos da el impacto exacto del movimiento.
     return new_score - old_score;
 }
+
+int HardConstraints::calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs,
+                                            int employee_id, int day, int new_shift) const {
+    HardScoreVector delta;
+    calculateEmployeeDelta(schedule, runs, employee_id, day, new_shift, delta);
+    return static_cast<int>(delta.total());
+}
+
+void HardConstraints::calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs,
+                                             int employee_id, int day, int new_shift, HardScoreVector& delta) const {
+    if (day < 0 || day >= schedule.getHorizonDays()) return;
+    int old_shift = schedule.getAssignment(employee_id, day);
+    if (old_shift == new_shift) return;
+    
+    HardScoreVector change;
+    change[HardConstraintType::SHIFT_ROTATION] = rotationDelta(schedule, employee_id, day, old_shift, new_shift);
+    change[HardConstraintType::MAX_SHIFTS_PER_TYPE] = maxShiftsDelta(schedule, employee_id, old_shift, new_shift);
+    change[HardConstraintType::WORKING_TIME_CONSTRAINTS] = workingTimeDelta(schedule, employee_id, old_shift, new_shift);
+    change[HardConstraintType::PRE_ASSIGNED_DAYS_OFF] = preAssignedDelta(employee_id, day, old_shift, new_shift);
+    
+    // Restricciones (5)-(7) y (9): solo cambian si el día pasa de trabajado a libre o al revés
+    if ((old_shift != 0) != (new_shift != 0)) {
+        calculateRunConstraintsDelta(runs, employee_id, day, new_shift != 0, change);
+        change[HardConstraintType::MAX_WEEKENDS_WORKED] = weekendsDelta(schedule, employee_id, day, old_shift, new_shift);
+    }
+    
+    if (delta_cross_check) {
+        ScheduleView patched = schedule;
+        patched.setAssignment(employee_id, day, new_shift);
+        crossCheckDelta(schedule, patched, employee_id, change,
+                        "day " + std::to_string(day) + ", shift " + std::to_string(old_shift) +
+                        " -> " + std::to_string(new_shift));
+    }
+    delta += change;
+}
+
+void HardConstraints::crossCheckDelta(const ScheduleView& schedule, const ScheduleView& patched, int employee,
+                                      const HardScoreVector& delta, const std::string& cells) const {
+    HardScoreVector full_delta = evaluateEmployeeByType(patched, employee);
+    full_delta -= evaluateEmployeeByType(schedule, employee);
+    for (int type = 0; type < NUM_HARD_CONSTRAINT_TYPES; type++) {
+        if (delta.values[type] != full_delta.values[type]) {
+            throw std::logic_error("HardConstraints: local delta " + std::to_string(delta.values[type]) +
+                                   " != full delta " + std::to_string(full_delta.values[type]) +
+                                   " for constraint type " + std::to_string(type) + ", employee " +
+                                   std::to_string(employee) + ", " + cells);
+        }
+    }
+}
+
+int HardConstraints::rotationDelta(const ScheduleView& schedule, int employee, int day, int old_shift, int new_shift) const {
+    // Solo los pares (d-1, d) y (d, d+1) contienen la celda
+    int penalty_change = 0;
+    if (day > 0) {
+        int prev = schedule.getAssignment(employee, day - 1);
+        penalty_change += (isValidShiftTransition(prev, old_shift) ? 0 : 100) -
+                          (isValidShiftTransition(prev, new_shift) ? 0 : 100);
+    }
+    if (day + 1 < schedule.getHorizonDays()) {
+        int next = schedule.getAssignment(employee, day + 1);
+        penalty_change += (isValidShiftTransition(old_shift, next) ? 0 : 100) -
+                          (isValidShiftTransition(new_shift, next) ? 0 : 100);
+    }
+    return penalty_change;
+}
+
+int HardConstraints::maxShiftsDelta(const ScheduleView& schedule, int employee, int old_shift, int new_shift) const {
+    // Un turno de old_shift menos y uno de new_shift más; cada unidad sobre el máximo cuesta 10
+    auto excess = [&](int shift, int count) {
+        return std::max(0, count - compiled.getMaxShifts(employee, shift));
+    };
+    int delta = 0;
+    if (old_shift != 0) {
+        int count = schedule.getShiftCount(employee, old_shift);
+        delta += 10 * (excess(old_shift, count) - excess(old_shift, count - 1));
+    }
+    if (new_shift != 0) {
+        int count = schedule.getShiftCount(employee, new_shift);
+        delta -= 10 * (excess(new_shift, count + 1) - excess(new_shift, count));
+    }
+    return delta;
+}
+
+int HardConstraints::workingTimeDelta(const ScheduleView& schedule, int employee, int old_shift, int new_shift) const {
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee);
+    const std::vector<int>& durations = instance.getShiftDurations();
+    auto minutes = [&](int shift) {
+        return (shift > 0 && shift <= static_cast<int>(durations.size())) ? durations[shift - 1] : 0;
+    };
+    auto penalty = [&](int total) {
+        return (total > limits.max_total_minutes ? -10 : 0) + (total < limits.min_total_minutes ? -10 : 0);
+    };
+    
+    int total = schedule.tracksMinutes() ?
+        schedule.getTotalMinutes(employee) :
+        schedule.getTotalMinutes(employee, durations);
+    return penalty(total - minutes(old_shift) + minutes(new_shift)) - penalty(total);
+}
+
+int HardConstraints::weekendsDelta(const ScheduleView& schedule, int employee, int day, int old_shift, int new_shift) const {
+    // Solo el fin de semana que contiene el día puede cambiar de trabajado a libre
+    int horizon = schedule.getHorizonDays();
+    int saturday = (day % 7 == 5) ? day : (day % 7 == 6 ? day - 1 : -1);
+    if (saturday < 0 || saturday + 1 >= horizon) return 0;
+    
+    int other_day = (saturday == day) ? saturday + 1 : saturday;
+    if (schedule.getAssignment(employee, other_day) != 0) return 0;  // Stays worked either way
+    
+    int max_weekends = compiled.getLimits(employee).max_weekends;
+    int weekends = countWeekendsWorked(schedule, employee);
+    int new_weekends = weekends + (new_shift != 0 ? 1 : 0) - (old_shift != 0 ? 1 : 0);
+    return -100 * std::max(0, new_weekends - max_weekends) + 100 * std::max(0, weekends - max_weekends);
+}
+
+int HardConstraints::preAssignedDelta(int employee, int day, int old_shift, int new_shift) const {
+    if (frozen_cells_enforced || !compiled.isDayOff(employee, day)) return 0;
+    return -1000 * ((new_shift != 0 ? 1 : 0) - (old_shift != 0 ? 1 : 0));
+}
+
+int HardConstraints::calculateRunConstraintsDelta(const RunIndex& runs, int employee_id, int day, bool working) const {
+    HardScoreVector delta;
+    calculateRunConstraintsDelta(runs, employee_id, day, working, delta);
+    return static_cast<int>(delta.total());
+}
+
+void HardConstraints::calculateRunConstraintsDelta(const RunIndex& runs, int employee_id, int day, bool working,
+                                                   HardScoreVector& delta) const {
+    RunIndex::Run current = runs.runContaining(employee_id, day);
+    if (current.working == working) return;
+    
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    int horizon = runs.getHorizonDays();
+    
+    // Runs alternate, so the runs right before and after 'current' already have the new
+    // status and merge with the flipped day when it sits on the edge of its run
+    bool joins_previous = (day == current.start && day > 0);
+    bool joins_next = (day + 1 == current.end && day + 1 < horizon);
+    
+    addRunPenalty(delta, limits, current.length(), current.working, -1);
+    int merged_start = day;
+    int merged_end = day + 1;
+    if (joins_previous) {
+        RunIndex::Run previous = runs.runContaining(employee_id, day - 1);
+        addRunPenalty(delta, limits, previous.length(), previous.working, -1);
+        merged_start = previous.start;
+    }
+    if (joins_next) {
+        RunIndex::Run next = runs.runContaining(employee_id, day + 1);
+        addRunPenalty(delta, limits, next.length(), next.working, -1);
+        merged_end = next.end;
+    }
+    
+    // The flipped day splits 'current' into what is left on either side of it
+    addRunPenalty(delta, limits, merged_end - merged_start, working, +1);
+    if (day > current.start) {
+        addRunPenalty(delta, limits, day - current.start, current.working, +1);
+    }
+    if (day + 1 < current.end) {
+        addRunPenalty(delta, limits, current.end - day - 1, current.working, +1);
+    }
+}
+
+int HardConstraints::calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs, int employee_id,
+                                            const std::vector<CellChange>& changes) const {
+    HardScoreVector delta;
+    calculateEmployeeDelta(schedule, runs, employee_id, changes, delta);
+    return static_cast<int>(delta.total());
+}
+
+void HardConstraints::calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs, int employee_id,
+                                             const std::vector<CellChange>& changes, HardScoreVector& delta) const {
+    if (changes.empty()) return;
+    if (changes.size() == 1) {
+        calculateEmployeeDelta(schedule, runs, employee_id, changes[0].day, changes[0].shift, delta);
+        return;
+    }
+    
+    int horizon = schedule.getHorizonDays();
+    const std::vector<int>& durations = instance.getShiftDurations();
+    auto minutes = [&](int shift) {
+        return (shift > 0 && shift <= static_cast<int>(durations.size())) ? durations[shift - 1] : 0;
+    };
+    auto shiftAfter = [&](int day) {
+        auto it = std::lower_bound(changes.begin(), changes.end(), day,
+                                   [](const CellChange& change, int d) { return change.day < d; });
+        return (it != changes.end() && it->day == day) ? it->shift : schedule.getAssignment(employee_id, day);
+    };
+    
+    HardScoreVector change_scores;
+    int minutes_change = 0;
+    int weekends_change = 0;
+    bool status_changes = false;
+    int last_pair = -1;      // Last rotation pair (p, p+1) already counted
+    int last_saturday = -1;  // Last weekend already counted
+    for (const CellChange& change : changes) {
+        int day = change.day;
+        int old_shift = schedule.getAssignment(employee_id, day);
+        int new_shift = change.shift;
+        if (old_shift == new_shift) continue;
+        
+        // Rotación: pares (d-1, d) y (d, d+1), una sola vez aunque dos días cambiados sean vecinos
+        for (int pair = std::max(day - 1, last_pair + 1); pair <= day && pair + 1 < horizon; pair++) {
+            bool was_valid = isValidShiftTransition(schedule.getAssignment(employee_id, pair),
+                                                    schedule.getAssignment(employee_id, pair + 1));
+            bool is_valid = isValidShiftTransition(shiftAfter(pair), shiftAfter(pair + 1));
+            change_scores[HardConstraintType::SHIFT_ROTATION] += (was_valid ? 0 : 100) - (is_valid ? 0 : 100);
+            last_pair = pair;
+        }
+        
+        if (old_shift != 0) shift_count_scratch[old_shift]--;
+        if (new_shift != 0) shift_count_scratch[new_shift]++;
+        minutes_change += minutes(new_shift) - minutes(old_shift);
+        change_scores[HardConstraintType::PRE_ASSIGNED_DAYS_OFF] += preAssignedDelta(employee_id, day, old_shift, new_shift);
+        
+        if ((old_shift != 0) != (new_shift != 0)) {
+            status_changes = true;
+            int saturday = (day % 7 == 5) ? day : (day % 7 == 6 ? day - 1 : -1);
+            if (saturday >= 0 && saturday + 1 < horizon && saturday != last_saturday) {
+                bool was_worked = schedule.getAssignment(employee_id, saturday) != 0 ||
+                                  schedule.getAssignment(employee_id, saturday + 1) != 0;
+                bool is_worked = shiftAfter(saturday) != 0 || shiftAfter(saturday + 1) != 0;
+                weekends_change += (is_worked ? 1 : 0) - (was_worked ? 1 : 0);
+                last_saturday = saturday;
+            }
+        }
+    }
+    
+    // (3): solo los tipos de turno cuyo contador cambia
+    for (int shift = 1; shift < static_cast<int>(shift_count_scratch.size()); shift++) {
+        int count_change = shift_count_scratch[shift];
+        if (count_change == 0) continue;
+        shift_count_scratch[shift] = 0;
+        int max_shifts = compiled.getMaxShifts(employee_id, shift);
+        int count = schedule.getShiftCount(employee_id, shift);
+        change_scores[HardConstraintType::MAX_SHIFTS_PER_TYPE] -=
+            10 * (std::max(0, count + count_change - max_shifts) - std::max(0, count - max_shifts));
+    }
+    
+    // (4)
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    if (minutes_change != 0) {
+        auto penalty = [&](int total) {
+            return (total > limits.max_total_minutes ? -10 : 0) + (total < limits.min_total_minutes ? -10 : 0);
+        };
+        int total = schedule.tracksMinutes() ?
+            schedule.getTotalMinutes(employee_id) :
+            schedule.getTotalMinutes(employee_id, durations);
+        change_scores[HardConstraintType::WORKING_TIME_CONSTRAINTS] = penalty(total + minutes_change) - penalty(total);
+    }
+    
+    // (9)
+    if (weekends_change != 0) {
+        int weekends = countWeekendsWorked(schedule, employee_id);
+        change_scores[HardConstraintType::MAX_WEEKENDS_WORKED] =
+            -100 * std::max(0, weekends + weekends_change - limits.max_weekends) +
+            100 * std::max(0, weekends - limits.max_weekends);
+    }
+    
+    // (5)-(7)
+    if (status_changes) {
+        calculateRunConstraintsDelta(runs, employee_id, changes, change_scores);
+    }
+    
+    if (delta_cross_check) {
+        ScheduleView patched = schedule;
+        for (const CellChange& change : changes) {
+            patched.setAssignment(employee_id, change.day, change.shift);
+        }
+        crossCheckDelta(schedule, patched, employee_id, change_scores,
+                        std::to_string(changes.size()) + " cells from day " + std::to_string(changes.front().day));
+    }
+    delta += change_scores;
+}
+
+int HardConstraints::calculateRunConstraintsDelta(const RunIndex& runs, int employee_id,
+                                                  const std::vector<CellChange>& changes) const {
+    HardScoreVector delta;
+    calculateRunConstraintsDelta(runs, employee_id, changes, delta);
+    return static_cast<int>(delta.total());
+}
+
+void HardConstraints::calculateRunConstraintsDelta(const RunIndex& runs, int employee_id,
+                                                   const std::vector<CellChange>& changes, HardScoreVector& delta) const {
+    if (changes.empty()) return;
+    const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(employee_id);
+    int horizon = runs.getHorizonDays();
+    
+    // Ventana: desde la racha anterior a la del primer cambio hasta la posterior a la
+    // del último. Sus extremos no cambian, así que las rachas de fuera no se ven afectadas
+    RunIndex::Run first_run = runs.runContaining(employee_id, changes.front().day);
+    RunIndex::Run last_run = runs.runContaining(employee_id, changes.back().day);
+    int window_start = first_run.start > 0 ? runs.runContaining(employee_id, first_run.start - 1).start : 0;
+    int window_end = last_run.end < horizon ? runs.runContaining(employee_id, last_run.end).end : horizon;
+    
+    int new_run_start = window_start;
+    bool new_run_working = false;
+    // Extends the current new run with [day, ...) of the given status, closing it on a status change
+    auto extend = [&](int day, bool working) {
+        if (day == window_start) {
+            new_run_working = working;
+        } else if (working != new_run_working) {
+            addRunPenalty(delta, limits, day - new_run_start, new_run_working, +1);
+            new_run_start = day;
+            new_run_working = working;
+        }
+    };
+    
+    size_t next_change = 0;
+    for (int start = window_start; start < window_end;) {
+        RunIndex::Run run = runs.runContaining(employee_id, start);
+        addRunPenalty(delta, limits, run.length(), run.working, -1);
+        if (next_change == changes.size() || changes[next_change].day >= run.end) {
+            extend(run.start, run.working);  // Untouched run: one segment
+        } else {
+            for (int day = run.start; day < run.end; day++) {
+                bool working = run.working;
+                if (next_change < changes.size() && changes[next_change].day == day) {
+                    working = changes[next_change].shift != 0;
+                    next_change++;
+                }
+                extend(day, working);
+            }
+        }
+        start = run.end;
+    }
+    addRunPenalty(delta, limits, window_end - new_run_start, new_run_working, +1);
+}
@@ -2,11 +2,57 @@
 #define HARD_CONSTRAINTS_H
 
 #include "../core/data_structures.h"
+#include "../core/schedule_view.h"
+#include "../core/run_index.h"
 #include "../core/instance.h"
+#include "../core/score.h"
+#include <array>
 #include <vector>
 #include <string>
 #include <map>
 
+enum class HardConstraintType {
+    MAX_ONE_SHIFT_PER_DAY,
+    SHIFT_ROTATION,
+    MAX_SHIFTS_PER_TYPE,
+    WORKING_TIME_CONSTRAINTS,
+    MAX_CONSECUTIVE_SHIFTS,
+    MIN_CONSECUTIVE_SHIFTS,
+    MIN_CONSECUTIVE_DAYS_OFF,
+    MAX_WEEKENDS_WORKED,
+    PRE_ASSIGNED_DAYS_OFF
+};
+
+const int NUM_HARD_CONSTRAINT_TYPES = static_cast<int>(HardConstraintType::PRE_ASSIGNED_DAYS_OFF) + 1;
+
+/**
+ * Hard score split by constraint type (indexed by HardConstraintType), so
+ * deltas can be kept per type and weighted afterwards. total() is the plain
+ * hard score.
+ */
+struct HardScoreVector {
+    std::array<Score, NUM_HARD_CONSTRAINT_TYPES> values{};
+    
+    Score& operator[](HardConstraintType type) { return values[static_cast<size_t>(type)]; }
+    Score operator[](HardConstraintType type) const { return values[static_cast<size_t>(type)]; }
+    
+    Score total() const {
+        Score sum = 0;
+        for (Score value : values) sum += value;
+        return sum;
+    }
+    HardScoreVector& operator+=(const HardScoreVector& other) {
+        for (int i = 0; i < NUM_HARD_CONSTRAINT_TYPES; i++) values[i] += other.values[i];
+        return *this;
+    }
+    HardScoreVector& operator-=(const HardScoreVector& other) {
+        for (int i = 0; i < NUM_HARD_CONSTRAINT_TYPES; i++) values[i] -= other.values[i];
+        return *this;
+    }
+    bool operator==(const HardScoreVector& other) const { return values == other.values; }
+    bool operator!=(const HardScoreVector& other) const { return values != other.values; }
+};
+
 /**
  * HardConstraints class implements all hard constraints from the NSP formulation
  * Based on constraints (1-11) from the research paper:
@@ -26,14 +72,46 @@
 class HardConstraints {
 private:
     const Instance& instance;
+    const CompiledInstance& compiled;  // Integer limits and days off, no string parsing while evaluating
+    
+    // Saturday bits (day % 7 == 5 with a following Sunday) for the instance horizon
+    std::vector<uint64_t> weekend_mask;
+    // Reused buffer for the work bitmask of a patched employee row
+    mutable std::vector<uint64_t> work_scratch;
+    mutable std::vector<int> shift_count_scratch;  // [shift] = count change of a multi-cell delta
+    // Set when every caller keeps pre-assigned days off (the frozen cells) empty,
+    // so constraint (10) cannot be violated and is not evaluated
+    bool frozen_cells_enforced;
+    // Set to verify every local delta against a full re-evaluation of the row
+    bool delta_cross_check;
     
     // Helper methods for constraint evaluation
+    static std::vector<uint64_t> buildWeekendMask(int horizon);
+    const uint64_t* workBits(const ScheduleView& schedule, int employee) const;
+    void addRunPenalty(HardScoreVector& scores, const CompiledInstance::EmployeeLimits& limits,
+                       int length, bool working, int sign) const;
     bool isValidShiftTransition(int current_shift, int next_shift) const;
-    int countConsecutiveWork(const Schedule& schedule, int employee, int start_day) const;
-    int countConsecutiveDaysOff(const Schedule& schedule, int employee, int start_day) const;
-    int countWeekendsWorked(const Schedule& schedule, int employee) const;
+    int countConsecutiveWork(const ScheduleView& schedule, int employee, int start_day) const;
+    int countConsecutiveDaysOff(const ScheduleView& schedule, int employee, int start_day) const;
+    int countWeekendsWorked(const ScheduleView& schedule, int employee) const;
+    
+    // Local deltas of single constraints for one cell changing from old_shift to new_shift
+    int rotationDelta(const ScheduleView& schedule, int employee, int day, int old_shift, int new_shift) const;
+    int maxShiftsDelta(const ScheduleView& schedule, int employee, int old_shift, int new_shift) const;
+    int workingTimeDelta(const ScheduleView& schedule, int employee, int old_shift, int new_shift) const;
+    int weekendsDelta(const ScheduleView& schedule, int employee, int day, int old_shift, int new_shift) const;
+    int preAssignedDelta(int employee, int day, int old_shift, int new_shift) const;
+    // Throws std::logic_error unless 'delta' equals the full re-evaluation of the row
+    void crossCheckDelta(const ScheduleView& schedule, const ScheduleView& patched, int employee,
+                         const HardScoreVector& delta, const std::string& cells) const;
     
 public:
+    // One cell of an employee's row taking a new shift, for multi-cell deltas
+    struct CellChange {
+        int day;
+        int shift;
+    };
+    
     explicit HardConstraints(const Instance& inst);
     
     // Individual constraint evaluation methods
@@ -50,56 +128,64 @@ public:
      * Ensures proper rest between incompatible shift types
      */
     int evaluateShiftRotation(const Schedule& schedule) const;
-    int evaluateShiftRotation(const Schedule& schedule, int employee_id) const;
+    int evaluateShiftRotation(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (3): Maximum shifts of type t for employee i
      * Limits the number of each shift type per employee
      */
     int evaluateMaxShiftsPerType(const Schedule& schedule) const;
-    int evaluateMaxShiftsPerType(const Schedule& schedule, int employee_id) const;
+    int evaluateMaxShiftsPerType(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (4): Min/max minutes worked
      * Ensures employees work within their time limits
      */
     int evaluateWorkingTimeConstraints(const Schedule& schedule) const;
-    int evaluateWorkingTimeConstraints(const Schedule& schedule, int employee_id) const;
+    int evaluateWorkingTimeConstraints(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (5): Maximum consecutive shifts
      * Limits consecutive working days
      */
     int evaluateMaxConsecutiveShifts(const Schedule& schedule) const;
-    int evaluateMaxConsecutiveShifts(const Schedule& schedule, int employee_id) const;
+    int evaluateMaxConsecutiveShifts(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (6): Minimum consecutive shifts
      * Ensures minimum consecutive working periods
      */
     int evaluateMinConsecutiveShifts(const Schedule& schedule) const;
-    int evaluateMinConsecutiveShifts(const Schedule& schedule, int employee_id) const;
+    int evaluateMinConsecutiveShifts(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (7): Minimum consecutive days off
      * Ensures adequate rest periods
      */
     int evaluateMinConsecutiveDaysOff(const Schedule& schedule) const;
-    int evaluateMinConsecutiveDaysOff(const Schedule& schedule, int employee_id) const;
+    int evaluateMinConsecutiveDaysOff(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (9): Maximum weekends worked
      * Limits weekend work assignments
      */
     int evaluateMaxWeekendsWorked(const Schedule& schedule) const;
-    int evaluateMaxWeekendsWorked(const Schedule& schedule, int employee_id) const;
+    int evaluateMaxWeekendsWorked(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Constraint (10): Pre-assigned days off
      * Enforces mandatory days off
      */
     int evaluatePreAssignedDaysOff(const Schedule& schedule) const;
-    int evaluatePreAssignedDaysOff(const Schedule& schedule, int employee_id) const;
+    int evaluatePreAssignedDaysOff(const ScheduleView& schedule, int employee_id) const;
+    
+    /**
+     * Declares that no schedule evaluated from now on puts work on a frozen
+     * cell (see CompiledInstance::isDayOff), so constraint (10) is skipped and
+     * scores 0. Only valid while every move source honors the frozen mask.
+     */
+    void setFrozenCellsEnforced(bool enforced) { frozen_cells_enforced = enforced; }
+    bool areFrozenCellsEnforced() const { return frozen_cells_enforced; }
     
     // Aggregate evaluation methods
     
@@ -123,7 +209,11 @@ public:
      * @param employee Employee index
      * @return Penalty score for this employee
      */
-    int evaluateEmployee(const Schedule& schedule, int employee) const;
+    int evaluateEmployee(const ScheduleView& schedule, int employee) const;
+    
+    // Same penalties split by constraint type, for one employee or the whole schedule
+    HardScoreVector evaluateEmployeeByType(const ScheduleView& schedule, int employee) const;
+    HardScoreVector evaluateAllByType(const Schedule& schedule) const;
     
     /**
      * Evaluates the impact of changing a single assignment
@@ -180,7 +270,58 @@ public:
      * @param new_shift El nuevo turno que se asignaría.
      * @return El cambio en la puntuación (delta). Un valor positivo indica una mejora.
      */
-    int calculateEmployeeDelta(const Schedule& schedule, int employee_id, int day, int new_shift) const;
+    int calculateEmployeeDelta(const ScheduleView& schedule, int employee_id, int day, int new_shift) const;
+    
+    /**
+     * Igual que la anterior, pero cada restricción calcula su cambio solo en la
+     * zona afectada: rotación con los días d-1 y d+1, (3) y (4) con los contadores
+     * del horario, (5)-(7) con el índice de rachas y (9) con el fin de semana del
+     * día. No recorre la fila: O(log rachas + palabras de la máscara de trabajo).
+     * El resultado es idéntico al de evaluateEmployee (ver setDeltaCrossCheck).
+     * @param runs Índice de rachas sincronizado con 'schedule' para este empleado.
+     */
+    int calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs,
+                               int employee_id, int day, int new_shift) const;
+    // Same, adding the change of each constraint type into 'delta'
+    void calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs,
+                                int employee_id, int day, int new_shift, HardScoreVector& delta) const;
+    
+    /**
+     * Cambio en las restricciones (5)-(7) si el día pasa a ser trabajado o libre.
+     * Solo mira la racha que contiene el día y sus vecinas: O(log rachas).
+     */
+    int calculateRunConstraintsDelta(const RunIndex& runs, int employee_id, int day, bool working) const;
+    void calculateRunConstraintsDelta(const RunIndex& runs, int employee_id, int day, bool working,
+                                      HardScoreVector& delta) const;
+    
+    /**
+     * Delta de varias celdas de la misma fila cambiadas a la vez (un intercambio
+     * dentro de la fila o la parte de un BlockSwap de un empleado). Cada restricción
+     * se evalúa sobre la ventana que tocan los cambios, teniendo en cuenta las
+     * interacciones entre días cambiados vecinos; no copia ni recorre la fila.
+     * @param changes Días distintos dentro del horizonte, en orden creciente.
+     */
+    int calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs, int employee_id,
+                               const std::vector<CellChange>& changes) const;
+    void calculateEmployeeDelta(const ScheduleView& schedule, const RunIndex& runs, int employee_id,
+                                const std::vector<CellChange>& changes, HardScoreVector& delta) const;
+    
+    /**
+     * Cambio en (5)-(7) cuando varios días de la fila cambian de estado a la vez.
+     * Recorre las rachas que contienen los cambios y sus vecinas, nada más.
+     */
+    int calculateRunConstraintsDelta(const RunIndex& runs, int employee_id,
+                                     const std::vector<CellChange>& changes) const;
+    void calculateRunConstraintsDelta(const RunIndex& runs, int employee_id,
+                                      const std::vector<CellChange>& changes, HardScoreVector& delta) const;
+    
+    /**
+     * Cross-check mode for the local delta: every call is also recomputed by
+     * re-evaluating the whole row, and a mismatch throws std::logic_error.
+     * Much slower; meant for tests and debugging runs.
+     */
+    void setDeltaCrossCheck(bool enabled) { delta_cross_check = enabled; }
+    bool isDeltaCrossCheckEnabled() const { return delta_cross_check; }
 };
 
 #endif // HARD_CONSTRAINTS_H
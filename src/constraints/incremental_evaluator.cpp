@@ -1,42 +1,50 @@
 #include "incremental_evaluator.h"
 #include "../core/data_structures.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
 IncrementalEvaluator::IncrementalEvaluator(ConstraintEvaluator& evaluator, const Schedule& initial_schedule)
-    : evaluator(evaluator), current_schedule(initial_schedule) {
+    : evaluator(evaluator), current_schedule(initial_schedule),
+      candidate_lists(evaluator.instance.getCompiled()) {
     reset(initial_schedule);
 }
 
-double IncrementalEvaluator::getTotalScore() const {
-    return current_hard_score + current_soft_score;
+Score IncrementalEvaluator::getTotalScore() const {
+    return current_hard_scores.total() + current_soft_score;
 }
 
-double IncrementalEvaluator::getHardScore() const {
-    return current_hard_score;
+Score IncrementalEvaluator::getHardScore() const {
+    return current_hard_scores.total();
 }
 
-double IncrementalEvaluator::getSoftScore() const {
+Score IncrementalEvaluator::getSoftScore() const {
     return current_soft_score;
 }
 
-Schedule IncrementalEvaluator::getCurrentSchedule() const {
+const Schedule& IncrementalEvaluator::getCurrentSchedule() const {
     return current_schedule;
 }
 
 void IncrementalEvaluator::applyMove(const Move& move) {
     // Calculate deltas BEFORE modifying the schedule
-    double delta_hard = getHardScoreDelta(move);
-    double delta_soft = getSoftScoreDelta(move);
+    HardScoreVector delta_hard = getHardScoreDeltas(move);
+    Score delta_soft = getSoftScoreDelta(move);
     
     // Apply the move to the schedule
     if (move.type == MoveType::Change || move.type == MoveType::FixShiftRotation) {
         current_schedule.setAssignment(move.employee1, move.day1, move.shift2);
+        run_index.update(move.employee1, move.day1, move.shift2 != 0);
+        candidate_lists.update(current_schedule, move.employee1, move.day1);
     } else if (move.type == MoveType::Swap) {
         int original_shift1 = current_schedule.getAssignment(move.employee1, move.day1);
         int original_shift2 = current_schedule.getAssignment(move.employee2, move.day2);
         current_schedule.setAssignment(move.employee1, move.day1, original_shift2);
         current_schedule.setAssignment(move.employee2, move.day2, original_shift1);
+        run_index.update(move.employee1, move.day1, original_shift2 != 0);
+        run_index.update(move.employee2, move.day2, original_shift1 != 0);
+        candidate_lists.update(current_schedule, move.employee1, move.day1);
+        candidate_lists.update(current_schedule, move.employee2, move.day2);
     } else if (move.type == MoveType::BlockSwap) {
         for (int d = 0; d < move.block_size; ++d) {
             int day = move.day1 + d;
@@ -44,6 +52,10 @@ void IncrementalEvaluator::applyMove(const Move& move) {
             int shift2 = current_schedule.getAssignment(move.employee2, day);
             current_schedule.setAssignment(move.employee1, day, shift2);
             current_schedule.setAssignment(move.employee2, day, shift1);
+            run_index.update(move.employee1, day, shift2 != 0);
+            run_index.update(move.employee2, day, shift1 != 0);
+            candidate_lists.update(current_schedule, move.employee1, day);
+            candidate_lists.update(current_schedule, move.employee2, day);
         }
     } else if (move.type == MoveType::RuinAndRecreate) {
         reset(current_schedule);
@@ -51,68 +63,65 @@ void IncrementalEvaluator::applyMove(const Move& move) {
     }
     
     // Update scores incrementally
-    current_hard_score += delta_hard;
+    current_hard_scores += delta_hard;
     current_soft_score += delta_soft;
 }
 
-double IncrementalEvaluator::getHardScoreDelta(const Move& move) {
-    double total_delta = 0.0;
+Score IncrementalEvaluator::getHardScoreDelta(const Move& move) {
+    return getHardScoreDeltas(move).total();
+}
+
+HardScoreVector IncrementalEvaluator::getHardScoreDeltas(const Move& move) {
+    const HardConstraints& hard = evaluator.hard_constraints;
+    HardScoreVector delta;
     
     switch (move.type) {
         case MoveType::Change:
         case MoveType::FixShiftRotation: {
-            total_delta = evaluator.hard_constraints.calculateEmployeeDelta(current_schedule, move.employee1, move.day1, move.shift2);
+            hard.calculateEmployeeDelta(current_schedule, run_index, move.employee1, move.day1, move.shift2, delta);
             break;
         }
         case MoveType::Swap: {
-            // For swaps, we need to be careful about the order and what shifts we're swapping
             int current_shift1 = current_schedule.getAssignment(move.employee1, move.day1);
             int current_shift2 = current_schedule.getAssignment(move.employee2, move.day2);
             
-            // Employee1 changes from current_shift1 to current_shift2
-            double delta1 = evaluator.hard_constraints.calculateEmployeeDelta(current_schedule, move.employee1, move.day1, current_shift2);
-            
-            // Employee2 changes from current_shift2 to current_shift1
-            // We need to calculate this after the first change to account for interactions
-            Schedule temp_schedule = current_schedule;
-            temp_schedule.setAssignment(move.employee1, move.day1, current_shift2);
-            double delta2 = evaluator.hard_constraints.calculateEmployeeDelta(temp_schedule, move.employee2, move.day2, current_shift1);
-            
-            total_delta = delta1 + delta2;
+            if (move.employee1 != move.employee2) {
+                // Hard constraints are per employee, so the two changes do not interact
+                hard.calculateEmployeeDelta(current_schedule, run_index, move.employee1, move.day1, current_shift2, delta);
+                hard.calculateEmployeeDelta(current_schedule, run_index, move.employee2, move.day2, current_shift1, delta);
+            } else if (move.day1 != move.day2) {
+                // Both cells are on one row: evaluate them together so neighbouring days interact
+                row_changes.clear();
+                row_changes.push_back({move.day1, current_shift2});
+                row_changes.push_back({move.day2, current_shift1});
+                if (move.day2 < move.day1) {
+                    std::swap(row_changes[0], row_changes[1]);
+                }
+                hard.calculateEmployeeDelta(current_schedule, run_index, move.employee1, row_changes, delta);
+            }
             break;
         }
         case MoveType::BlockSwap: {
-            Schedule temp_schedule = current_schedule;
-            double old_total_score = evaluator.getEmployeeHardConstraintViolations(temp_schedule, move.employee1) +
-                                   evaluator.getEmployeeHardConstraintViolations(temp_schedule, move.employee2);
-            
-            for (int d = 0; d < move.block_size; ++d) {
-                int day = move.day1 + d;
-                int shift1 = temp_schedule.getAssignment(move.employee1, day);
-                int shift2 = temp_schedule.getAssignment(move.employee2, day);
-                temp_schedule.setAssignment(move.employee1, day, shift2);
-                temp_schedule.setAssignment(move.employee2, day, shift1);
-            }
-            
-            double new_total_score = evaluator.getEmployeeHardConstraintViolations(temp_schedule, move.employee1) +
-                                   evaluator.getEmployeeHardConstraintViolations(temp_schedule, move.employee2);
-            total_delta = new_total_score - old_total_score;
+            if (move.employee1 == move.employee2) break;
+            collectBlockChanges(move, move.employee1, move.employee2);
+            hard.calculateEmployeeDelta(current_schedule, run_index, move.employee1, row_changes, delta);
+            collectBlockChanges(move, move.employee2, move.employee1);
+            hard.calculateEmployeeDelta(current_schedule, run_index, move.employee2, row_changes, delta);
             break;
         }
         case MoveType::RuinAndRecreate: {
             // For RuinAndRecreate, we still need full re-evaluation
-            Schedule temp_schedule = current_schedule;
-            double new_hard_score = evaluator.getHardConstraintViolations(temp_schedule);
-            total_delta = new_hard_score - current_hard_score;
+            delta = hard.evaluateAllByType(current_schedule);
+            delta -= current_hard_scores;
             break;
         }
     }
     
-    return total_delta;
+    return delta;
 }
 
-double IncrementalEvaluator::getSoftScoreDelta(const Move& move) {
-    double total_delta = 0.0;
+Score IncrementalEvaluator::getSoftScoreDelta(const Move& move) {
+    Score total_delta = 0;
     
     switch (move.type) {
         case MoveType::Change:
@@ -144,25 +153,21 @@ double IncrementalEvaluator::getSoftScoreDelta(const Move& move) {
             break;
         }
         case MoveType::BlockSwap: {
-            Schedule temp_schedule = current_schedule;
-            double old_total_score = evaluator.getSoftConstraintViolations(temp_schedule);
-            
-            for (int d = 0; d < move.block_size; ++d) {
-                int day = move.day1 + d;
-                int shift1 = temp_schedule.getAssignment(move.employee1, day);
-                int shift2 = temp_schedule.getAssignment(move.employee2, day);
-                temp_schedule.setAssignment(move.employee1, day, shift2);
-                temp_schedule.setAssignment(move.employee2, day, shift1);
+            // Both employees trade the same days, so coverage is unchanged and only
+            // their requests on the exchanged cells can move
+            if (move.employee1 == move.employee2) break;
+            int last_day = std::min(move.day1 + move.block_size, current_schedule.getHorizonDays());
+            for (int day = std::max(move.day1, 0); day < last_day; ++day) {
+                int shift1 = current_schedule.getAssignment(move.employee1, day);
+                int shift2 = current_schedule.getAssignment(move.employee2, day);
+                total_delta += evaluator.soft_constraints.calculateEmployeeDelta(current_schedule, move.employee1, day, shift2);
+                total_delta += evaluator.soft_constraints.calculateEmployeeDelta(current_schedule, move.employee2, day, shift1);
             }
-            
-            double new_total_score = evaluator.getSoftConstraintViolations(temp_schedule);
-            total_delta = new_total_score - old_total_score;
             break;
         }
         case MoveType::RuinAndRecreate: {
             // For RuinAndRecreate, we still need full re-evaluation
-            Schedule temp_schedule = current_schedule;
-            double new_soft_score = evaluator.getSoftConstraintViolations(temp_schedule);
+            Score new_soft_score = evaluator.getSoftConstraintViolations(current_schedule);
             total_delta = new_soft_score - current_soft_score;
             break;
         }
@@ -171,8 +176,22 @@ double IncrementalEvaluator::getSoftScoreDelta(const Move& move) {
     return total_delta;
 }
 
+void IncrementalEvaluator::collectBlockChanges(const Move& move, int employee, int other) {
+    row_changes.clear();
+    int last_day = std::min(move.day1 + move.block_size, current_schedule.getHorizonDays());
+    for (int day = std::max(move.day1, 0); day < last_day; ++day) {
+        int shift = current_schedule.getAssignment(employee, day);
+        int other_shift = current_schedule.getAssignment(other, day);
+        if (shift != other_shift) {
+            row_changes.push_back({day, other_shift});
+        }
+    }
+}
+
 void IncrementalEvaluator::reset(const Schedule& schedule) {
     current_schedule = schedule;
-    current_hard_score = evaluator.getHardConstraintViolations(current_schedule);
+    run_index.rebuild(current_schedule);
+    candidate_lists.rebuild(current_schedule);
+    current_hard_scores = evaluator.hard_constraints.evaluateAllByType(current_schedule);
     current_soft_score = evaluator.getSoftConstraintViolations(current_schedule);
 }
@@ -3,25 +3,36 @@
 
 #include "constraint_evaluator.h"
 #include "../core/move.h"
+#include "../core/run_index.h"
+#include "../core/candidate_lists.h"
 
 class IncrementalEvaluator {
 public:
     IncrementalEvaluator(ConstraintEvaluator& evaluator, const Schedule& initial_schedule);
 
-    double getTotalScore() const;
-    double getHardScore() const;
-    double getSoftScore() const;
-    Schedule getCurrentSchedule() const;
+    Score getTotalScore() const;
+    Score getHardScore() const;
+    const HardScoreVector& getHardScores() const { return current_hard_scores; }
+    Score getSoftScore() const;
+    const Schedule& getCurrentSchedule() const;
+    const CandidateLists& getCandidateLists() const { return candidate_lists; }
     void applyMove(const Move& move);
-    double getHardScoreDelta(const Move& move);
-    double getSoftScoreDelta(const Move& move);
+    Score getHardScoreDelta(const Move& move);
+    HardScoreVector getHardScoreDeltas(const Move& move);
+    Score getSoftScoreDelta(const Move& move);
     void reset(const Schedule& schedule);
 
 private:
     ConstraintEvaluator& evaluator;
     Schedule current_schedule;
-    double current_hard_score;
-    double current_soft_score;
+    RunIndex run_index;  // Work/rest runs of current_schedule, updated with every applied move
+    CandidateLists candidate_lists;  // Legal employees per (day, shift), kept in sync like run_index
+    HardScoreVector current_hard_scores;  // Hard score per constraint type, updated by deltas
+    Score current_soft_score;
+    std::vector<HardConstraints::CellChange> row_changes;  // Scratch for multi-cell hard deltas
+    
+    // Fills row_changes with the cells 'employee' takes from 'other' over the move's block
+    void collectBlockChanges(const Move& move, int employee, int other);
 };
 
 #endif // INCREMENTAL_EVALUATOR_H
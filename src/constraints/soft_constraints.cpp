@@ -3,113 +3,79 @@
 #include <sstream>
 #include <iomanip>
 
-SoftConstraints::SoftConstraints(const Instance& inst) : instance(inst) {}
+SoftConstraints::SoftConstraints(const Instance& inst) : instance(inst), compiled(inst.getCompiled()) {}
 
 // Helper methods
 
 int SoftConstraints::findEmployeeIndex(const std::string& employee_id) const {
-    for (int i = 0; i < instance.getNumEmployees(); i++) {
-        if (instance.getStaff(i).ID == employee_id) {
-            return i;
-        }
-    }
-    return -1;
+    return instance.getStaffIndex(employee_id);
 }
 
 int SoftConstraints::findShiftIndex(const std::string& shift_id) const {
-    for (int i = 0; i < instance.getNumShiftTypes(); i++) {
-        if (instance.getShift(i).ShiftID == shift_id) {
-            return i + 1; // Return 1-based index for consistency with schedule
-        }
-    }
-    return -1;
+    int index = instance.getShiftIndex(shift_id);
+    return index >= 0 ? index + 1 : -1; // Return 1-based index for consistency with schedule
 }
 
-// Individual soft constraint evaluation methods
-
-int SoftConstraints::evaluateShiftOnRequests(const Schedule& schedule) const {
-    int score = 0;
-    int num_employees = schedule.getNumEmployees();
-    for (int emp = 0; emp < num_employees; emp++) {
-        score += evaluateShiftOnRequests(schedule, emp);
+int SoftConstraints::coverPenalty(int day, int shift, int coverage) const {
+    if (!compiled.hasCover(day, shift)) {
+        return 0;
     }
-    return score;
+    int required = compiled.getCoverRequirement(day, shift);
+    if (coverage > required) {
+        // Over-staffing penalty
+        return -(coverage - required) * compiled.getCoverWeightOver(day, shift);
+    }
+    if (coverage < required) {
+        // Under-staffing penalty
+        return -(required - coverage) * compiled.getCoverWeightUnder(day, shift);
+    }
+    return 0;
 }
 
-int SoftConstraints::evaluateShiftOnRequests(const Schedule& schedule, int employee_id) const {
+template <typename Request>
+int SoftConstraints::evaluateRequests(const ScheduleView& schedule, const std::vector<Request>& requests,
+                                      int employee_id) const {
     int score = 0;
-    const auto& on_requests = instance.getShiftOnRequests();
-    const Staff& worker = instance.getStaff(employee_id);
-
-    for (const auto& request : on_requests) {
-        if (request.EmployeeID == worker.ID) {
-            if (request.Day >= 0 && request.Day < schedule.getHorizonDays()) {
-                int assigned_shift = schedule.getAssignment(employee_id, request.Day);
-                if (assigned_shift != 0) {
-                    const Shift& shift_info = instance.getShift(assigned_shift - 1);
-                    if (shift_info.ShiftID == request.ShiftID) {
-                        score += request.Weight;
-                    }
-                }
-            }
+    int horizon = std::min(schedule.getHorizonDays(), compiled.getHorizonDays());
+    for (const auto& request : requests) {
+        if (request.Day < 0 || request.Day >= horizon) continue;
+        int emp = instance.getStaffIndex(request.EmployeeID);
+        if (emp < 0 || emp >= schedule.getNumEmployees() || (employee_id >= 0 && emp != employee_id)) continue;
+        int shift = findShiftIndex(request.ShiftID);
+        if (shift > 0 && schedule.getAssignment(emp, request.Day) == shift) {
+            score += request.Weight;
         }
     }
     return score;
 }
 
-int SoftConstraints::evaluateShiftOffRequests(const Schedule& schedule) const {
-    int score = 0;
-    int num_employees = schedule.getNumEmployees();
-    for (int emp = 0; emp < num_employees; emp++) {
-        score += evaluateShiftOffRequests(schedule, emp);
-    }
-    return score;
+// Individual soft constraint evaluation methods
+
+int SoftConstraints::evaluateShiftOnRequests(const Schedule& schedule) const {
+    return evaluateRequests(schedule, instance.getShiftOnRequests(), -1);
 }
 
-int SoftConstraints::evaluateShiftOffRequests(const Schedule& schedule, int employee_id) const {
-    int score = 0;
-    const auto& off_requests = instance.getShiftOffRequests();
-    const Staff& worker = instance.getStaff(employee_id);
+int SoftConstraints::evaluateShiftOnRequests(const ScheduleView& schedule, int employee_id) const {
+    return evaluateRequests(schedule, instance.getShiftOnRequests(), employee_id);
+}
 
-    for (const auto& request : off_requests) {
-        if (request.EmployeeID == worker.ID) {
-            if (request.Day >= 0 && request.Day < schedule.getHorizonDays()) {
-                int assigned_shift = schedule.getAssignment(employee_id, request.Day);
-                if (assigned_shift != 0) {
-                    const Shift& shift_info = instance.getShift(assigned_shift - 1);
-                    if (shift_info.ShiftID == request.ShiftID) {
-                        score += request.Weight; // Note: Weight should be negative for off-requests
-                    }
-                }
-            }
-        }
-    }
-    return score;
+int SoftConstraints::evaluateShiftOffRequests(const Schedule& schedule) const {
+    return evaluateRequests(schedule, instance.getShiftOffRequests(), -1);
+}
+
+int SoftConstraints::evaluateShiftOffRequests(const ScheduleView& schedule, int employee_id) const {
+    // Note: Weight should be negative for off-requests
+    return evaluateRequests(schedule, instance.getShiftOffRequests(), employee_id);
 }
 
 int SoftConstraints::evaluateCoverageRequirements(const Schedule& schedule) const {
     int score = 0;
-    const auto& cover_requirements = instance.getCoverageRequirements();
+    int horizon = std::min(schedule.getHorizonDays(), compiled.getHorizonDays());
+    int num_shifts = compiled.getNumShiftTypes();
     
-    for (const auto& cover : cover_requirements) {
-        if (cover.Day >= 0 && cover.Day < schedule.getHorizonDays()) {
-            int shift_index = findShiftIndex(cover.ShiftID);
-            
-            if (shift_index > 0) {
-                int actual_coverage = schedule.getCoverage(cover.Day, shift_index);
-                int required_coverage = cover.Requirement;
-                
-                if (actual_coverage > required_coverage) {
-                    // Over-staffing penalty
-                    int excess = actual_coverage - required_coverage;
-                    score -= excess * abs(cover.Weight_for_over);
-                } else if (actual_coverage < required_coverage) {
-                    // Under-staffing penalty
-                    int deficit = required_coverage - actual_coverage;
-                    score -= deficit * abs(cover.Weight_for_under);
-                }
-                // If actual_coverage == required_coverage, no penalty (score += 0)
-            }
+    for (int day = 0; day < horizon; day++) {
+        for (int shift = 1; shift <= num_shifts; shift++) {
+            score += coverPenalty(day, shift, schedule.getCoverage(day, shift));
         }
     }
     return score;
@@ -120,22 +86,30 @@ int SoftConstraints::evaluateCoverageRequirements(const Schedule& schedule) cons
 int SoftConstraints::evaluateAll(const Schedule& schedule) const {
     int total_score = 0;
     
-    total_score += evaluateShiftOnRequests(schedule);
-    total_score += evaluateShiftOffRequests(schedule);
+    // Shift-on and shift-off requests together, from the combined compiled table
+    int num_employees = schedule.getNumEmployees();
+    for (int emp = 0; emp < num_employees; emp++) {
+        total_score += evaluateEmployee(schedule, emp);
+    }
     total_score += evaluateCoverageRequirements(schedule);
     
     return total_score;
 }
 
-int SoftConstraints::evaluateEmployee(const Schedule& schedule, int employee) const {
+int SoftConstraints::evaluateEmployee(const ScheduleView& schedule, int employee) const {
     if (employee < 0 || employee >= schedule.getNumEmployees()) {
         return 0;
     }
     
     int score = 0;
-    score += evaluateShiftOnRequests(schedule, employee);
-    score += evaluateShiftOffRequests(schedule, employee);
-    
+    int horizon = std::min(schedule.getHorizonDays(), compiled.getHorizonDays());
+    int num_shifts = compiled.getNumShiftTypes();
+    for (int day = 0; day < horizon; day++) {
+        int assigned_shift = schedule.getAssignment(employee, day);
+        if (assigned_shift > 0 && assigned_shift <= num_shifts) {
+            score += compiled.getRequestWeights(employee, day)[assigned_shift];
+        }
+    }
     return score;
 }
 
@@ -429,50 +403,34 @@ std::map<std::string, int> SoftConstraints::getCoverageGaps(const Schedule& sche
 
 // Incremental evaluation methods
 
-int SoftConstraints::calculateEmployeeDelta(const Schedule& schedule, int employee_id, int day, int new_shift) const {
-    int old_score = evaluateEmployee(schedule, employee_id); // Evalúa On/Off requests para el estado actual
-    Schedule temp_schedule = schedule;
-    temp_schedule.setAssignment(employee_id, day, new_shift);
-    int new_score = evaluateEmployee(temp_schedule, employee_id); // Evalúa On/Off requests para el estado nuevo
-    return new_score - old_score;
+int SoftConstraints::calculateEmployeeDelta(const ScheduleView& schedule, int employee_id, int day, int new_shift) const {
+    // Requests only depend on the cell itself, so the delta is two lookups in the request index
+    if (day < 0 || day >= compiled.getHorizonDays()) {
+        return 0;
+    }
+    int num_shifts = compiled.getNumShiftTypes();
+    int old_shift = schedule.getAssignment(employee_id, day);
+    const int* weights = compiled.getRequestWeights(employee_id, day);
+    int old_weight = (old_shift > 0 && old_shift <= num_shifts) ? weights[old_shift] : 0;
+    int new_weight = (new_shift > 0 && new_shift <= num_shifts) ? weights[new_shift] : 0;
+    return new_weight - old_weight;
 }
 
-int SoftConstraints::calculateCoverageDelta(const Schedule& schedule, int day, int old_shift, int new_shift) const {
-    if (old_shift == new_shift) {
+int SoftConstraints::calculateCoverageDelta(const ScheduleView& schedule, int day, int old_shift, int new_shift) const {
+    if (old_shift == new_shift || day < 0 || day >= compiled.getHorizonDays()) {
         return 0; // Si no hay cambio de turno, no hay cambio de cobertura.
     }
     
-    int delta = 0;
-    const auto& cover_requirements = instance.getCoverageRequirements();
+    int num_shifts = compiled.getNumShiftTypes();
     
-    // Función lambda para calcular el cambio de penalización para un solo turno
-    auto get_penalty_change = [&](int shift, int change) { // change es +1 o -1
-        if (shift <= 0) return 0;
-        int penalty_change = 0;
-        for (const auto& cover : cover_requirements) {
-            if (cover.Day == day && findShiftIndex(cover.ShiftID) == shift) {
-                int current_coverage = schedule.getCoverage(day, shift);
-                int required = cover.Requirement;
-                int new_coverage = current_coverage + change;
-                
-                int old_penalty = (current_coverage < required) ? (current_coverage - required) * abs(cover.Weight_for_under) :
-                                 (current_coverage > required) ? (current_coverage - required) * abs(cover.Weight_for_over) : 0;
-                                 
-                int new_penalty = (new_coverage < required) ? (new_coverage - required) * abs(cover.Weight_for_under) :
-                                 (new_coverage > required) ? (new_coverage - required) * abs(cover.Weight_for_over) : 0;
-                                 
-                penalty_change = new_penalty - old_penalty;
-                break;
-            }
-        }
-        return penalty_change;
+    // Cambio de penalización de un solo turno cuando su cobertura varía en 'change' (+1 o -1)
+    auto get_penalty_change = [&](int shift, int change) {
+        if (shift <= 0 || shift > num_shifts) return 0;
+        int current_coverage = schedule.getCoverage(day, shift);
+        return coverPenalty(day, shift, current_coverage + change) - coverPenalty(day, shift, current_coverage);
     };
     
-    // Al dejar el 'old_shift', la cobertura de ese turno disminuye en 1.
-    delta += get_penalty_change(old_shift, -1);
-    
-    // Al tomar el 'new_shift', la cobertura de ese turno aumenta en 1.
-    delta += get_penalty_change(new_shift, +1);
-    
-    return delta;
+    // Al dejar el 'old_shift', la cobertura de ese turno disminuye en 1;
+    // al tomar el 'new_shift', la cobertura de ese turno aumenta en 1.
+    return get_penalty_change(old_shift, -1) + get_penalty_change(new_shift, +1);
 }
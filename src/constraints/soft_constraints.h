@@ -2,6 +2,7 @@
 #define SOFT_CONSTRAINTS_H
 
 #include "../core/data_structures.h"
+#include "../core/schedule_view.h"
 #include "../core/instance.h"
 #include <vector>
 #include <string>
@@ -19,10 +20,17 @@
 class SoftConstraints {
 private:
     const Instance& instance;
+    const CompiledInstance& compiled;  // Dense request and cover tables
     
     // Helper methods
     int findEmployeeIndex(const std::string& employee_id) const;
     int findShiftIndex(const std::string& shift_id) const;
+    int coverPenalty(int day, int shift, int coverage) const;  // 0 or negative; 0 without a cover
+
+    // Weight of the granted entries of 'requests' (all employees if 'employee_id' is -1).
+    // The compiled table only keeps on + off combined, so the split scans the Instance lists.
+    template <typename Request>
+    int evaluateRequests(const ScheduleView& schedule, const std::vector<Request>& requests, int employee_id) const;
     
 public:
     explicit SoftConstraints(const Instance& inst);
@@ -37,7 +45,7 @@ public:
      * @return Positive score for satisfied requests
      */
     int evaluateShiftOnRequests(const Schedule& schedule) const;
-    int evaluateShiftOnRequests(const Schedule& schedule, int employee_id) const;
+    int evaluateShiftOnRequests(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Evaluates shift-off requests (employees want to avoid specific shifts)
@@ -46,7 +54,7 @@ public:
      * @return Negative score for violated off-requests
      */
     int evaluateShiftOffRequests(const Schedule& schedule) const;
-    int evaluateShiftOffRequests(const Schedule& schedule, int employee_id) const;
+    int evaluateShiftOffRequests(const ScheduleView& schedule, int employee_id) const;
     
     /**
      * Evaluates coverage requirements for all shifts and days
@@ -71,7 +79,7 @@ public:
      * @param employee Employee index
      * @return Soft constraint score for this employee
      */
-    int evaluateEmployee(const Schedule& schedule, int employee) const;
+    int evaluateEmployee(const ScheduleView& schedule, int employee) const;
     
     /**
      * Evaluates the impact of changing a single assignment on soft constraints
@@ -157,14 +165,15 @@ public:
     
     /**
      * Calcula el delta en la puntuación de las preferencias de un empleado (On/Off Requests).
+     * O(1): solo consulta el índice de peticiones del instance compilado para la celda.
      */
-    int calculateEmployeeDelta(const Schedule& schedule, int employee_id, int day, int new_shift) const;
+    int calculateEmployeeDelta(const ScheduleView& schedule, int employee_id, int day, int new_shift) const;
     
     /**
      * Calcula el delta en la puntuación de cobertura para un día específico
      * si un turno se deja y otro se toma.
      */
-    int calculateCoverageDelta(const Schedule& schedule, int day, int old_shift, int new_shift) const;
+    int calculateCoverageDelta(const ScheduleView& schedule, int day, int old_shift, int new_shift) const;
 };
 
 #endif // SOFT_CONSTRAINTS_H
@@ -0,0 +1,73 @@
+#include "candidate_lists.h"
+#include "../utils/random.h"
+#include <algorithm>
+
+CandidateLists::CandidateLists()
+    : compiled(nullptr), num_employees(0), horizon_days(0), num_shift_types(0) {}
+
+CandidateLists::CandidateLists(const CompiledInstance& compiled)
+    : compiled(&compiled),
+      num_employees(compiled.getNumEmployees()),
+      horizon_days(compiled.getHorizonDays()),
+      num_shift_types(compiled.getNumShiftTypes()),
+      candidates(static_cast<size_t>(horizon_days) * (num_shift_types + 1)),
+      positions(static_cast<size_t>(num_employees) * horizon_days * (num_shift_types + 1), -1) {}
+
+bool CandidateLists::isLegal(const Schedule& schedule, int employee, int day, int shift) const {
+    if (compiled->isDayOff(employee, day) || compiled->getMaxShifts(employee, shift) == 0) {
+        return false;
+    }
+    int prev = day > 0 ? schedule.getAssignment(employee, day - 1) : 0;
+    int next = day + 1 < horizon_days ? schedule.getAssignment(employee, day + 1) : 0;
+    return !compiled->isForbiddenTransition(prev, shift) && !compiled->isForbiddenTransition(shift, next);
+}
+
+void CandidateLists::refreshCell(const Schedule& schedule, int employee, int day) {
+    for (int shift = 1; shift <= num_shift_types; shift++) {
+        int& position = positions[positionIndex(employee, day, shift)];
+        bool legal = isLegal(schedule, employee, day, shift);
+        if (legal == (position >= 0)) continue;
+
+        std::vector<int>& list = candidates[listIndex(day, shift)];
+        if (legal) {
+            position = static_cast<int>(list.size());
+            list.push_back(employee);
+        } else {
+            // Swap-remove: the last member takes the freed slot
+            int last = list.back();
+            list[position] = last;
+            positions[positionIndex(last, day, shift)] = position;
+            list.pop_back();
+            position = -1;
+        }
+    }
+}
+
+void CandidateLists::rebuild(const Schedule& schedule) {
+    for (auto& list : candidates) {
+        list.clear();
+    }
+    std::fill(positions.begin(), positions.end(), -1);
+    for (int emp = 0; emp < num_employees; emp++) {
+        for (int day = 0; day < horizon_days; day++) {
+            refreshCell(schedule, emp, day);
+        }
+    }
+}
+
+void CandidateLists::update(const Schedule& schedule, int employee, int day) {
+    if (day > 0) {
+        refreshCell(schedule, employee, day - 1);
+    }
+    if (day + 1 < horizon_days) {
+        refreshCell(schedule, employee, day + 1);
+    }
+}
+
+int CandidateLists::sample(int day, int shift) const {
+    const std::vector<int>& list = candidates[listIndex(day, shift)];
+    if (list.empty()) {
+        return -1;
+    }
+    return list[Random::getInt(0, static_cast<int>(list.size()) - 1)];
+}
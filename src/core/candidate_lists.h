@@ -0,0 +1,57 @@
+#ifndef CANDIDATE_LISTS_H
+#define CANDIDATE_LISTS_H
+
+#include "data_structures.h"
+#include "compiled_instance.h"
+#include <vector>
+
+/**
+ * For every (day, shift), the employees that can take that shift on that day
+ * without breaking a rule that is local to the cell: the cell is not a
+ * pre-assigned day off, MaxShifts for the shift is not 0, and the shift may
+ * follow the employee's previous day and precede their next day.
+ *
+ * Each list is an unordered vector plus a position table, so membership
+ * changes and uniform sampling are O(1). An employee's own assignment on a
+ * day never affects its legality there; changing it only affects the two
+ * neighbouring days, which update() re-checks in O(shift types).
+ *
+ * Like RunIndex, the lists are kept in sync by their owner
+ * (IncrementalEvaluator) as moves are applied.
+ */
+class CandidateLists {
+private:
+    const CompiledInstance* compiled;
+    int num_employees;
+    int horizon_days;
+    int num_shift_types;
+
+    std::vector<std::vector<int>> candidates;  // [day * (num_shift_types + 1) + shift] = employees
+    std::vector<int> positions;                // [(employee * horizon_days + day) * (num_shift_types + 1) + shift], -1 if absent
+
+    size_t listIndex(int day, int shift) const { return static_cast<size_t>(day) * (num_shift_types + 1) + shift; }
+    size_t positionIndex(int employee, int day, int shift) const {
+        return (static_cast<size_t>(employee) * horizon_days + day) * (num_shift_types + 1) + shift;
+    }
+    bool isLegal(const Schedule& schedule, int employee, int day, int shift) const;
+    void refreshCell(const Schedule& schedule, int employee, int day);
+
+public:
+    CandidateLists();
+    explicit CandidateLists(const CompiledInstance& compiled);
+
+    // Recomputes every list from the schedule
+    void rebuild(const Schedule& schedule);
+
+    // Records that the cell ('employee', 'day') of 'schedule' has changed
+    void update(const Schedule& schedule, int employee, int day);
+
+    // Employees that can take 'shift' (1-based) on 'day', in no particular order
+    const std::vector<int>& getCandidates(int day, int shift) const { return candidates[listIndex(day, shift)]; }
+    bool contains(int employee, int day, int shift) const { return positions[positionIndex(employee, day, shift)] >= 0; }
+
+    // A uniformly drawn candidate for ('day', 'shift'), or -1 if there is none
+    int sample(int day, int shift) const;
+};
+
+#endif // CANDIDATE_LISTS_H
@@ -0,0 +1,224 @@
+#include "compiled_instance.h"
+#include "instance.h"
+#include "../utils/bit_utils.h"
+#include "../utils/binary_io.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+
+const int CompiledInstance::NO_LIMIT;
+const int CompiledInstance::NO_COVER;
+
+CompiledInstance::CompiledInstance()
+    : num_employees(0), horizon_days(0), num_shift_types(0), transition_words(0), days_off_words(0),
+      num_employee_classes(0) {}
+
+bool CompiledInstance::build(const Instance& instance) {
+    num_employees = instance.getNumEmployees();
+    horizon_days = instance.getHorizonDays();
+    num_shift_types = instance.getNumShiftTypes();
+
+    // Staff limits; MaxShifts entries are positional, one per shift type
+    limits.clear();
+    limits.reserve(num_employees);
+    max_shifts.assign(static_cast<size_t>(num_employees) * num_shift_types, NO_LIMIT);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const Staff& worker = instance.getStaff(emp);
+        limits.push_back({worker.MaxTotalMinutes, worker.MinTotalMinutes,
+                          worker.MaxConsecutiveShifts, worker.MinConsecutiveShifts,
+                          worker.MinConsecutiveDaysOff, worker.MaxWeekends});
+
+        int entries = std::min(static_cast<int>(worker.MaxShifts.size()), num_shift_types);
+        for (int i = 0; i < entries; i++) {
+            if (worker.MaxShifts[i] == "None") continue;
+            try {
+                max_shifts[static_cast<size_t>(emp) * num_shift_types + i] = std::stoi(worker.MaxShifts[i]);
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+    }
+
+    // Rotation rules, matched on the full ShiftID; unknown ids never match
+    transition_words = BitUtils::wordsFor(num_shift_types + 1);
+    forbidden_transitions.assign(static_cast<size_t>(num_shift_types + 1) * transition_words, 0);
+    for (int prev = 1; prev <= num_shift_types; prev++) {
+        uint64_t* row = forbidden_transitions.data() + static_cast<size_t>(prev) * transition_words;
+        for (const auto& id : instance.getShift(prev - 1).cant_follow) {
+            int next = instance.getShiftIndex(id) + 1;
+            if (next > 0) {
+                BitUtils::setBit(row, next);
+            }
+        }
+    }
+
+    // Days off: only the first line of each employee counts, as in the hard constraint
+    days_off_words = BitUtils::wordsFor(horizon_days);
+    days_off_bits.assign(static_cast<size_t>(num_employees) * days_off_words, 0);
+    std::vector<bool> has_days_off(num_employees, false);
+    for (const auto& days_off : instance.getDaysOff()) {
+        int emp = instance.getStaffIndex(days_off.EmployeeID);
+        if (emp < 0 || has_days_off[emp]) continue;
+        has_days_off[emp] = true;
+        for (const auto& day_str : days_off.DayIndexes) {
+            int day;
+            try {
+                day = std::stoi(day_str);
+            } catch (const std::exception&) {
+                continue;  // Invalid day format, skip
+            }
+            if (day >= 0 && day < horizon_days) {
+                BitUtils::setBit(days_off_bits.data() + static_cast<size_t>(emp) * days_off_words, day);
+            }
+        }
+    }
+
+    // Requests; unknown employees or shifts can never be matched and are dropped
+    size_t request_cells = static_cast<size_t>(num_employees) * horizon_days * (num_shift_types + 1);
+    request_weights.assign(request_cells, 0);
+    for (const auto& request : instance.getShiftOnRequests()) {
+        int emp = instance.getStaffIndex(request.EmployeeID);
+        int shift = instance.getShiftIndex(request.ShiftID) + 1;
+        if (emp >= 0 && shift > 0 && request.Day >= 0 && request.Day < horizon_days) {
+            request_weights[requestIndex(emp, request.Day, shift)] += request.Weight;
+        }
+    }
+    for (const auto& request : instance.getShiftOffRequests()) {
+        int emp = instance.getStaffIndex(request.EmployeeID);
+        int shift = instance.getShiftIndex(request.ShiftID) + 1;
+        if (emp >= 0 && shift > 0 && request.Day >= 0 && request.Day < horizon_days) {
+            request_weights[requestIndex(emp, request.Day, shift)] += request.Weight;
+        }
+    }
+
+    // Covers; the first entry for a (day, shift) wins
+    size_t cover_cells = static_cast<size_t>(horizon_days) * (num_shift_types + 1);
+    cover_requirements.assign(cover_cells, NO_COVER);
+    cover_weights_under.assign(cover_cells, 0);
+    cover_weights_over.assign(cover_cells, 0);
+    for (const auto& cover : instance.getCoverageRequirements()) {
+        int shift = instance.getShiftIndex(cover.ShiftID) + 1;
+        if (shift <= 0 || cover.Day < 0 || cover.Day >= horizon_days) continue;
+        size_t index = coverIndex(cover.Day, shift);
+        if (cover_requirements[index] != NO_COVER) continue;
+        cover_requirements[index] = cover.Requirement;
+        cover_weights_under[index] = std::abs(cover.Weight_for_under);
+        cover_weights_over[index] = std::abs(cover.Weight_for_over);
+    }
+
+    buildEquivalenceClasses();
+    return true;
+}
+
+void CompiledInstance::buildEquivalenceClasses() {
+    // Contract: staff limits plus the MaxShifts row
+    std::map<std::vector<int>, int> contracts;
+    contract_class.resize(num_employees);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const EmployeeLimits& limit = limits[emp];
+        std::vector<int> key = {limit.max_total_minutes, limit.min_total_minutes,
+                                limit.max_consecutive_shifts, limit.min_consecutive_shifts,
+                                limit.min_consecutive_days_off, limit.max_weekends};
+        key.insert(key.end(), max_shifts.begin() + static_cast<size_t>(emp) * num_shift_types,
+                   max_shifts.begin() + static_cast<size_t>(emp + 1) * num_shift_types);
+        contract_class[emp] = contracts.emplace(std::move(key), emp).first->second;
+    }
+
+    // Day pattern: the frozen bit followed by the request weights of each shift
+    std::map<std::vector<int>, int> patterns;
+    std::vector<int> free_day(num_shift_types + 2, 0);
+    patterns.emplace(free_day, 0);
+    day_patterns.resize(static_cast<size_t>(num_employees) * horizon_days);
+    for (int emp = 0; emp < num_employees; emp++) {
+        for (int day = 0; day < horizon_days; day++) {
+            const int* weights = getRequestWeights(emp, day);
+            std::vector<int> key(1, isDayOff(emp, day) ? 1 : 0);
+            key.insert(key.end(), weights, weights + num_shift_types + 1);
+            int next_id = static_cast<int>(patterns.size());
+            day_patterns[static_cast<size_t>(emp) * horizon_days + day] = patterns.emplace(std::move(key), next_id).first->second;
+        }
+    }
+
+    // Employee: contract class followed by the pattern of every day
+    std::map<std::vector<int>, int> classes;
+    employee_class.resize(num_employees);
+    for (int emp = 0; emp < num_employees; emp++) {
+        std::vector<int> key(1, contract_class[emp]);
+        key.insert(key.end(), day_patterns.begin() + static_cast<size_t>(emp) * horizon_days,
+                   day_patterns.begin() + static_cast<size_t>(emp + 1) * horizon_days);
+        employee_class[emp] = classes.emplace(std::move(key), emp).first->second;
+    }
+    num_employee_classes = static_cast<int>(classes.size());
+}
+
+void CompiledInstance::save(BinaryWriter& out) const {
+    out.writeInt(num_employees);
+    out.writeInt(horizon_days);
+    out.writeInt(num_shift_types);
+    out.writeVector(limits);
+    out.writeVector(max_shifts);
+    out.writeInt(transition_words);
+    out.writeVector(forbidden_transitions);
+    out.writeInt(days_off_words);
+    out.writeVector(days_off_bits);
+    out.writeVector(request_weights);
+    out.writeVector(cover_requirements);
+    out.writeVector(cover_weights_under);
+    out.writeVector(cover_weights_over);
+}
+
+bool CompiledInstance::restore(BinaryReader& in) {
+    num_employees = in.readInt();
+    horizon_days = in.readInt();
+    num_shift_types = in.readInt();
+    limits = in.readVector<EmployeeLimits>();
+    max_shifts = in.readVector<int>();
+    transition_words = in.readInt();
+    forbidden_transitions = in.readVector<uint64_t>();
+    days_off_words = in.readInt();
+    days_off_bits = in.readVector<uint64_t>();
+    request_weights = in.readVector<int>();
+    cover_requirements = in.readVector<int>();
+    cover_weights_under = in.readVector<int>();
+    cover_weights_over = in.readVector<int>();
+    if (!in.ok() || num_employees < 0 || horizon_days < 0 || num_shift_types < 0) {
+        return false;
+    }
+
+    size_t employees = num_employees;
+    size_t request_cells = employees * horizon_days * (num_shift_types + 1);
+    size_t cover_cells = static_cast<size_t>(horizon_days) * (num_shift_types + 1);
+    bool consistent = limits.size() == employees &&
+           max_shifts.size() == employees * num_shift_types &&
+           transition_words == BitUtils::wordsFor(num_shift_types + 1) &&
+           forbidden_transitions.size() == static_cast<size_t>(num_shift_types + 1) * transition_words &&
+           days_off_words == BitUtils::wordsFor(horizon_days) &&
+           days_off_bits.size() == employees * days_off_words &&
+           request_weights.size() == request_cells &&
+           cover_requirements.size() == cover_cells &&
+           cover_weights_under.size() == cover_cells &&
+           cover_weights_over.size() == cover_cells;
+    if (consistent) {
+        buildEquivalenceClasses();
+    }
+    return consistent;
+}
+
+bool CompiledInstance::isDayOff(int employee, int day) const {
+    if (employee < 0 || employee >= num_employees || day < 0 || day >= horizon_days) {
+        return false;
+    }
+    return BitUtils::testBit(getDaysOffBits(employee), day);
+}
+
+size_t CompiledInstance::getMemoryFootprint() const {
+    return sizeof(*this) +
+           limits.capacity() * sizeof(EmployeeLimits) +
+           max_shifts.capacity() * sizeof(int) +
+           forbidden_transitions.capacity() * sizeof(uint64_t) +
+           days_off_bits.capacity() * sizeof(uint64_t) +
+           request_weights.capacity() * sizeof(int) +
+           (cover_requirements.capacity() + cover_weights_under.capacity() + cover_weights_over.capacity()) * sizeof(int) +
+           (contract_class.capacity() + day_patterns.capacity() + employee_class.capacity()) * sizeof(int);
+}
@@ -0,0 +1,138 @@
+#ifndef COMPILED_INSTANCE_H
+#define COMPILED_INSTANCE_H
+
+#include "../utils/bit_utils.h"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Instance;
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * Integer-only view of an Instance, compiled once by Instance::loadFromFile.
+ *
+ * Every string-keyed field the evaluators need (staff limits, MaxShifts,
+ * DayIndexes, requests and covers keyed by EmployeeID/ShiftID) is resolved to
+ * indices up front and stored in dense arrays, so evaluation never parses or
+ * compares strings. Shifts use the schedule's 1-based ids (0 = day off).
+ * The view is immutable: only Instance can build it.
+ */
+class CompiledInstance {
+public:
+    static const int NO_LIMIT = INT_MAX;  // MaxShifts entry "None" or missing
+    static const int NO_COVER = -1;       // No cover requirement for a (day, shift)
+
+    struct EmployeeLimits {
+        int max_total_minutes;
+        int min_total_minutes;
+        int max_consecutive_shifts;
+        int min_consecutive_shifts;
+        int min_consecutive_days_off;
+        int max_weekends;
+    };
+
+private:
+    int num_employees;
+    int horizon_days;
+    int num_shift_types;
+
+    std::vector<EmployeeLimits> limits;  // [employee]
+    std::vector<int> max_shifts;         // [employee * num_shift_types + shift - 1]
+
+    // Shift rotation: bit 'next' of row 'prev' is set when 'next' cannot follow 'prev'.
+    // Rows and bits use 1-based shift ids; row 0 (day off) is always empty.
+    int transition_words;
+    std::vector<uint64_t> forbidden_transitions;  // [prev * transition_words + next / 64]
+
+    // Pre-assigned days off: bit d of an employee's row is set when day d must be off
+    int days_off_words;
+    std::vector<uint64_t> days_off_bits;  // [employee * days_off_words + day / 64]
+
+    // Shift-on and shift-off request weights summed per cell, so the soft score of
+    // one assignment is a single lookup; entry 0 (day off) is 0. The on/off split is
+    // not kept: SoftConstraints recomputes it from the Instance when asked for it.
+    std::vector<int> request_weights;  // [(employee * horizon_days + day) * (num_shift_types + 1) + shift]
+
+    // Cover requirements and absolute under/over weights
+    std::vector<int> cover_requirements;  // [day * (num_shift_types + 1) + shift], NO_COVER when absent
+    std::vector<int> cover_weights_under;
+    std::vector<int> cover_weights_over;
+
+    // Employee symmetry, derived from the tables above (never stored in the cache).
+    // Class ids are the smallest employee index of the class.
+    std::vector<int> contract_class;  // [employee], same limits and MaxShifts
+    std::vector<int> day_patterns;    // [employee * horizon_days + day], 0 = not frozen and no requests
+    std::vector<int> employee_class;  // [employee], same contract and the same pattern every day
+    int num_employee_classes;
+
+    size_t requestIndex(int employee, int day, int shift) const {
+        return (static_cast<size_t>(employee) * horizon_days + day) * (num_shift_types + 1) + shift;
+    }
+    size_t coverIndex(int day, int shift) const {
+        return static_cast<size_t>(day) * (num_shift_types + 1) + shift;
+    }
+
+    // Returns false if a MaxShifts entry is neither a number nor "None"
+    bool build(const Instance& instance);
+    void buildEquivalenceClasses();
+    friend class Instance;
+
+    // Binary form used by InstanceCache; restore() rejects tables whose sizes do not match
+    void save(BinaryWriter& out) const;
+    bool restore(BinaryReader& in);
+    friend class InstanceCache;
+
+public:
+    CompiledInstance();
+
+    int getNumEmployees() const { return num_employees; }
+    int getHorizonDays() const { return horizon_days; }
+    int getNumShiftTypes() const { return num_shift_types; }
+
+    const EmployeeLimits& getLimits(int employee) const { return limits[employee]; }
+    int getMaxShifts(int employee, int shift) const {
+        return max_shifts[static_cast<size_t>(employee) * num_shift_types + shift - 1];
+    }
+
+    // Shifts that cannot be worked the day after 'prev', as a bitset over shift ids
+    const uint64_t* getForbiddenFollowers(int prev) const {
+        return forbidden_transitions.data() + static_cast<size_t>(prev) * transition_words;
+    }
+    bool isForbiddenTransition(int prev, int next) const {
+        return BitUtils::testBit(getForbiddenFollowers(prev), next);
+    }
+
+    const uint64_t* getDaysOffBits(int employee) const {
+        return days_off_bits.data() + static_cast<size_t>(employee) * days_off_words;
+    }
+    int getDaysOffWords() const { return days_off_words; }
+    bool isDayOff(int employee, int day) const;
+
+    // Combined on/off weights of one (employee, day), indexed by shift id
+    const int* getRequestWeights(int employee, int day) const { return request_weights.data() + requestIndex(employee, day, 0); }
+
+    bool hasCover(int day, int shift) const { return cover_requirements[coverIndex(day, shift)] != NO_COVER; }
+    int getCoverRequirement(int day, int shift) const { return cover_requirements[coverIndex(day, shift)]; }
+    int getCoverWeightUnder(int day, int shift) const { return cover_weights_under[coverIndex(day, shift)]; }
+    int getCoverWeightOver(int day, int shift) const { return cover_weights_over[coverIndex(day, shift)]; }
+
+    /**
+     * Employee equivalence classes. Two employees in the same contract class
+     * are interchangeable for every hard constraint and for coverage; on a day
+     * where they also share the day pattern (frozen or not, same request
+     * weights), exchanging their cells cannot change any score. Employees in
+     * the same employee class share the pattern on every day, so their whole
+     * rows are interchangeable.
+     */
+    int getContractClass(int employee) const { return contract_class[employee]; }
+    int getDayPattern(int employee, int day) const { return day_patterns[static_cast<size_t>(employee) * horizon_days + day]; }
+    int getEmployeeClass(int employee) const { return employee_class[employee]; }
+    int getNumEmployeeClasses() const { return num_employee_classes; }
+
+    size_t getMemoryFootprint() const;
+};
+
+#endif // COMPILED_INSTANCE_H
@@ -1,76 +1,277 @@
 #include "data_structures.h"
+#include "instance.h"
+#include "../utils/bit_utils.h"
 #include <random>
 #include <chrono>
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+std::atomic<size_t> Schedule::buffer_allocations(0);
 
 Schedule::Schedule(int employees, int days, int shift_types) 
-    : num_employees(employees), horizon_days(days), num_shift_types(shift_types), cache_valid(false) {
-    assignments.resize(employees);
-    for (int i = 0; i < employees; i++) {
-        assignments[i].resize(days, 0);  // Initialize with 0 (no shift)
+    : num_employees(employees), horizon_days(days), num_shift_types(shift_types), zobrist_hash(0) {
+    if (shift_types < 0 || shift_types > MAX_SHIFT_TYPES) {
+        throw std::invalid_argument("Schedule: number of shift types must be between 0 and " +
+                                    std::to_string(MAX_SHIFT_TYPES));
+    }
+    buffer_allocations++;
+    
+    // Single row-major buffer, initialized with 0 (no shift)
+    assignments.assign(static_cast<size_t>(employees) * days, 0);
+    
+    // Every employee starts on shift 0 for every day
+    coverage.assign(static_cast<size_t>(days) * (shift_types + 1), 0);
+    for (int day = 0; day < days; day++) {
+        coverage[static_cast<size_t>(day) * (shift_types + 1)] = employees;
+    }
+    
+    // Every employee starts with all days on shift 0 and no minutes worked
+    shift_counts.assign(static_cast<size_t>(employees) * (shift_types + 1), 0);
+    for (int emp = 0; emp < employees; emp++) {
+        shift_counts[static_cast<size_t>(emp) * (shift_types + 1)] = days;
     }
+    total_minutes.assign(employees, 0);
     
-    // Initialize cache structures
-    shift_counts.resize(employees);
-    total_minutes.resize(employees, 0);
+    work_words = BitUtils::wordsFor(days);
+    work_bits.assign(static_cast<size_t>(employees) * work_words, 0);
+}
+
+Schedule::Schedule(const Instance& instance)
+    : Schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes()) {
+    setShiftDurations(instance.getShiftDurations());
 }
 
 Schedule::Schedule(const Schedule& other) 
     : num_employees(other.num_employees), horizon_days(other.horizon_days), 
-      num_shift_types(other.num_shift_types), cache_valid(other.cache_valid) {
+      num_shift_types(other.num_shift_types), zobrist_hash(other.zobrist_hash),
+      work_words(other.work_words) {
+    buffer_allocations++;
     assignments = other.assignments;
+    coverage = other.coverage;
     shift_counts = other.shift_counts;
+    shift_minutes = other.shift_minutes;
     total_minutes = other.total_minutes;
+    work_bits = other.work_bits;
 }
 
 Schedule& Schedule::operator=(const Schedule& other) {
     if (this != &other) {
+        // std::vector copy assignment keeps the existing storage when it is large enough
+        if (assignments.capacity() < other.assignments.size() ||
+            coverage.capacity() < other.coverage.size() ||
+            shift_counts.capacity() < other.shift_counts.size() ||
+            shift_minutes.capacity() < other.shift_minutes.size() ||
+            total_minutes.capacity() < other.total_minutes.size() ||
+            work_bits.capacity() < other.work_bits.size()) {
+            buffer_allocations++;
+        }
         num_employees = other.num_employees;
         horizon_days = other.horizon_days;
         num_shift_types = other.num_shift_types;
         assignments = other.assignments;
-        cache_valid = other.cache_valid;
+        coverage = other.coverage;
         shift_counts = other.shift_counts;
+        shift_minutes = other.shift_minutes;
         total_minutes = other.total_minutes;
+        zobrist_hash = other.zobrist_hash;
+        work_words = other.work_words;
+        work_bits = other.work_bits;
+    }
+    return *this;
+}
+
+Schedule::Schedule(Schedule&& other) noexcept
+    : assignments(std::move(other.assignments)),
+      num_employees(std::exchange(other.num_employees, 0)),
+      horizon_days(std::exchange(other.horizon_days, 0)),
+      num_shift_types(std::exchange(other.num_shift_types, 0)),
+      coverage(std::move(other.coverage)),
+      shift_counts(std::move(other.shift_counts)),
+      shift_minutes(std::move(other.shift_minutes)),
+      total_minutes(std::move(other.total_minutes)),
+      zobrist_hash(std::exchange(other.zobrist_hash, 0)),
+      work_words(std::exchange(other.work_words, 0)),
+      work_bits(std::move(other.work_bits)) {}
+
+Schedule& Schedule::operator=(Schedule&& other) noexcept {
+    if (this != &other) {
+        assignments = std::move(other.assignments);
+        num_employees = std::exchange(other.num_employees, 0);
+        horizon_days = std::exchange(other.horizon_days, 0);
+        num_shift_types = std::exchange(other.num_shift_types, 0);
+        coverage = std::move(other.coverage);
+        shift_counts = std::move(other.shift_counts);
+        shift_minutes = std::move(other.shift_minutes);
+        total_minutes = std::move(other.total_minutes);
+        zobrist_hash = std::exchange(other.zobrist_hash, 0);
+        work_words = std::exchange(other.work_words, 0);
+        work_bits = std::move(other.work_bits);
+        
+        // Leave 'other' consistent with its 0x0 shape
+        other.assignments.clear();
+        other.coverage.clear();
+        other.shift_counts.clear();
+        other.shift_minutes.clear();
+        other.total_minutes.clear();
+        other.work_bits.clear();
     }
     return *this;
 }
 
 void Schedule::setAssignment(int employee, int day, int shift) {
-    if (employee >= 0 && employee < num_employees && 
-        day >= 0 && day < horizon_days) {
-        assignments[employee][day] = shift;
-        invalidateCache();
+    if (isInBounds(employee, day)) {
+        Cell new_cell = toCell(shift);
+        Cell& cell = assignments[cellIndex(employee, day)];
+        onCellChanged(employee, day, cell, new_cell);
+        cell = new_cell;
+    }
+}
+
+void Schedule::onCellChanged(int employee, int day, int old_shift, int new_shift) {
+    updateCoverage(day, old_shift, new_shift);
+    updateCounters(employee, old_shift, new_shift);
+    int cell = cellIndex(employee, day);
+    zobrist_hash ^= cellKey(cell, old_shift) ^ cellKey(cell, new_shift);
+    
+    if ((old_shift != 0) != (new_shift != 0)) {
+        uint64_t* row_bits = work_bits.data() + static_cast<size_t>(employee) * work_words;
+        if (new_shift != 0) {
+            BitUtils::setBit(row_bits, day);
+        } else {
+            BitUtils::clearBit(row_bits, day);
+        }
+    }
+}
+
+Schedule::Cell Schedule::toCell(int shift) {
+    if (shift < 0 || shift > MAX_SHIFT_TYPES) {
+        throw std::out_of_range("Schedule: shift id " + std::to_string(shift) + " does not fit a cell");
+    }
+    return static_cast<Cell>(shift);
+}
+
+uint64_t Schedule::cellKey(int cell, int shift) {
+    // Day off contributes nothing, so an empty schedule hashes to 0
+    if (shift == 0) return 0;
+    
+    // splitmix64 finalizer: keys are derived on the fly, no key table to store or share
+    uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(cell)) << 32) ^ static_cast<uint32_t>(shift);
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void Schedule::rebuildWorkBits() {
+    std::fill(work_bits.begin(), work_bits.end(), 0);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const Cell* row = getEmployeeRow(emp);
+        uint64_t* row_bits = work_bits.data() + static_cast<size_t>(emp) * work_words;
+        for (int day = 0; day < horizon_days; day++) {
+            if (row[day] != 0) {
+                BitUtils::setBit(row_bits, day);
+            }
+        }
+    }
+}
+
+void Schedule::rebuildDerivedState() {
+    rebuildCoverage();
+    rebuildCounters();
+    rebuildHash();
+    rebuildWorkBits();
+}
+
+void Schedule::rebuildHash() {
+    zobrist_hash = 0;
+    for (size_t cell = 0; cell < assignments.size(); cell++) {
+        zobrist_hash ^= cellKey(static_cast<int>(cell), assignments[cell]);
     }
 }
 
-int Schedule::getAssignment(int employee, int day) const {
-    if (employee >= 0 && employee < num_employees && 
-        day >= 0 && day < horizon_days) {
-        return assignments[employee][day];
+void Schedule::updateCounters(int employee, int old_shift, int new_shift) {
+    if (old_shift == new_shift) return;
+    
+    int* counts = shift_counts.data() + static_cast<size_t>(employee) * (num_shift_types + 1);
+    if (isTrackedShift(old_shift)) {
+        counts[old_shift]--;
+        if (tracksMinutes()) total_minutes[employee] -= shift_minutes[old_shift];
+    }
+    if (isTrackedShift(new_shift)) {
+        counts[new_shift]++;
+        if (tracksMinutes()) total_minutes[employee] += shift_minutes[new_shift];
+    }
+}
+
+void Schedule::rebuildCounters() {
+    std::fill(shift_counts.begin(), shift_counts.end(), 0);
+    std::fill(total_minutes.begin(), total_minutes.end(), 0);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const Cell* row = getEmployeeRow(emp);
+        int* counts = shift_counts.data() + static_cast<size_t>(emp) * (num_shift_types + 1);
+        for (int day = 0; day < horizon_days; day++) {
+            if (isTrackedShift(row[day])) {
+                counts[row[day]]++;
+            }
+        }
+        if (tracksMinutes()) {
+            for (int shift = 1; shift <= num_shift_types; shift++) {
+                total_minutes[emp] += counts[shift] * shift_minutes[shift];
+            }
+        }
+    }
+}
+
+void Schedule::setShiftDurations(const std::vector<int>& shift_durations) {
+    shift_minutes.assign(num_shift_types + 1, 0);
+    for (int shift = 1; shift <= num_shift_types; shift++) {
+        if (shift <= static_cast<int>(shift_durations.size())) {
+            shift_minutes[shift] = shift_durations[shift - 1];
+        }
+    }
+    rebuildCounters();
+}
+
+void Schedule::updateCoverage(int day, int old_shift, int new_shift) {
+    if (old_shift == new_shift) return;
+    
+    int* day_coverage = coverage.data() + static_cast<size_t>(day) * (num_shift_types + 1);
+    if (isTrackedShift(old_shift)) day_coverage[old_shift]--;
+    if (isTrackedShift(new_shift)) day_coverage[new_shift]++;
+}
+
+void Schedule::rebuildCoverage() {
+    std::fill(coverage.begin(), coverage.end(), 0);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const Cell* row = getEmployeeRow(emp);
+        for (int day = 0; day < horizon_days; day++) {
+            if (isTrackedShift(row[day])) {
+                coverage[static_cast<size_t>(day) * (num_shift_types + 1) + row[day]]++;
+            }
+        }
     }
-    return 0;  // Default to no shift
 }
 
 void Schedule::randomize(int max_shifts) {
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, max_shifts);
+    std::uniform_int_distribution<> dis(0, toCell(max_shifts));
     
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            assignments[i][j] = dis(gen);
-        }
+    for (Cell& cell : assignments) {
+        cell = static_cast<Cell>(dis(gen));
     }
+    rebuildDerivedState();
 }
 
 void Schedule::copyFrom(const Schedule& other) {
     if (num_employees == other.num_employees && 
         horizon_days == other.horizon_days) {
         assignments = other.assignments;
+        rebuildDerivedState();
     }
 }
 
@@ -79,73 +280,49 @@ int** Schedule::getRawMatrix() const {
     int** matrix = new int*[num_employees];
     for (int i = 0; i < num_employees; i++) {
         matrix[i] = new int[horizon_days];
-        for (int j = 0; j < horizon_days; j++) {
-            matrix[i][j] = assignments[i][j];
-        }
+        std::copy_n(getEmployeeRow(i), horizon_days, matrix[i]);
     }
     return matrix;
 }
 
-void Schedule::setFromRawMatrix(int** matrix) {
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            assignments[i][j] = matrix[i][j];
-        }
-    }
-    invalidateCache();
-}
-
-// Cache management methods
-void Schedule::invalidateCache() const {
-    cache_valid = false;
+void Schedule::setFromCells(const Cell* cells) {
+    std::copy_n(cells, assignments.size(), assignments.begin());
+    rebuildDerivedState();
 }
 
-void Schedule::updateCache() const {
-    if (cache_valid) return;
-    
-    // Reset cache structures
-    for (int i = 0; i < num_employees; i++) {
-        shift_counts[i].clear();
-        total_minutes[i] = 0;
-    }
-    
-    // Rebuild cache from current assignments
+void Schedule::setFromRawMatrix(int** matrix) {
     for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            int shift = assignments[i][j];
-            if (shift > 0) {
-                shift_counts[i][shift]++;
-            }
-        }
-    }
-    
-    cache_valid = true;
-}
-
-void Schedule::ensureCacheValid() const {
-    if (!cache_valid) {
-        updateCache();
+        std::transform(matrix[i], matrix[i] + horizon_days, assignments.begin() + cellIndex(i, 0), toCell);
     }
+    rebuildDerivedState();
 }
 
 // Additional manipulation methods
 void Schedule::clear() {
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            assignments[i][j] = 0;
-        }
+    std::fill(assignments.begin(), assignments.end(), 0);
+    std::fill(coverage.begin(), coverage.end(), 0);
+    for (int day = 0; day < horizon_days; day++) {
+        coverage[static_cast<size_t>(day) * (num_shift_types + 1)] = num_employees;
     }
-    invalidateCache();
+    std::fill(shift_counts.begin(), shift_counts.end(), 0);
+    std::fill(total_minutes.begin(), total_minutes.end(), 0);
+    for (int emp = 0; emp < num_employees; emp++) {
+        shift_counts[static_cast<size_t>(emp) * (num_shift_types + 1)] = horizon_days;
+    }
+    zobrist_hash = 0;
+    std::fill(work_bits.begin(), work_bits.end(), 0);
 }
 
 void Schedule::swapAssignments(int emp1, int day1, int emp2, int day2) {
-    if (emp1 >= 0 && emp1 < num_employees && day1 >= 0 && day1 < horizon_days &&
-        emp2 >= 0 && emp2 < num_employees && day2 >= 0 && day2 < horizon_days) {
-        
-        int temp = assignments[emp1][day1];
-        assignments[emp1][day1] = assignments[emp2][day2];
-        assignments[emp2][day2] = temp;
-        invalidateCache();
+    if (isInBounds(emp1, day1) && isInBounds(emp2, day2)) {
+        Cell& cell1 = assignments[cellIndex(emp1, day1)];
+        Cell& cell2 = assignments[cellIndex(emp2, day2)];
+        Cell shift1 = cell1;
+        Cell shift2 = cell2;
+        onCellChanged(emp1, day1, shift1, shift2);
+        onCellChanged(emp2, day2, shift2, shift1);
+        cell1 = shift2;
+        cell2 = shift1;
     }
 }
 
@@ -153,20 +330,28 @@ void Schedule::swapAssignments(int emp1, int day1, int emp2, int day2) {
 int Schedule::getShiftCount(int employee, int shift_type) const {
     if (employee < 0 || employee >= num_employees) return 0;
     
-    ensureCacheValid();
-    auto it = shift_counts[employee].find(shift_type);
-    return (it != shift_counts[employee].end()) ? it->second : 0;
+    if (isTrackedShift(shift_type)) {
+        return shift_counts[static_cast<size_t>(employee) * (num_shift_types + 1) + shift_type];
+    }
+    
+    // Shift ids outside the declared range are not tracked, count them directly
+    const Cell* row = getEmployeeRow(employee);
+    return static_cast<int>(std::count(row, row + horizon_days, shift_type));
+}
+
+int Schedule::getTotalMinutes(int employee) const {
+    if (employee < 0 || employee >= num_employees) return 0;
+    return total_minutes[employee];
 }
 
 int Schedule::getTotalMinutes(int employee, const std::vector<int>& shift_durations) const {
     if (employee < 0 || employee >= num_employees) return 0;
     
     int total = 0;
-    for (int day = 0; day < horizon_days; day++) {
-        int shift = assignments[employee][day];
-        if (shift > 0 && shift <= static_cast<int>(shift_durations.size())) {
-            total += shift_durations[shift - 1];  // shift_durations is 0-indexed
-        }
+    const int* counts = shift_counts.data() + static_cast<size_t>(employee) * (num_shift_types + 1);
+    int last_shift = std::min(num_shift_types, static_cast<int>(shift_durations.size()));
+    for (int shift = 1; shift <= last_shift; shift++) {
+        total += counts[shift] * shift_durations[shift - 1];  // shift_durations is 0-indexed
     }
     return total;
 }
@@ -174,29 +359,15 @@ int Schedule::getTotalMinutes(int employee, const std::vector<int>& shift_durati
 int Schedule::getConsecutiveShifts(int employee, int start_day) const {
     if (employee < 0 || employee >= num_employees || start_day < 0) return 0;
     
-    int count = 0;
-    for (int day = start_day; day < horizon_days; day++) {
-        if (assignments[employee][day] != 0) {
-            count++;
-        } else {
-            break;
-        }
-    }
-    return count;
+    if (start_day >= horizon_days) return 0;
+    return BitUtils::nextClearBit(getWorkBits(employee), start_day, horizon_days) - start_day;
 }
 
 int Schedule::getConsecutiveDaysOff(int employee, int start_day) const {
     if (employee < 0 || employee >= num_employees || start_day < 0) return 0;
     
-    int count = 0;
-    for (int day = start_day; day < horizon_days; day++) {
-        if (assignments[employee][day] == 0) {
-            count++;
-        } else {
-            break;
-        }
-    }
-    return count;
+    if (start_day >= horizon_days) return 0;
+    return BitUtils::nextSetBit(getWorkBits(employee), start_day, horizon_days) - start_day;
 }
 
 bool Schedule::isWorkingWeekend(int employee, int weekend_start_day) const {
@@ -205,42 +376,33 @@ bool Schedule::isWorkingWeekend(int employee, int weekend_start_day) const {
         return false;
     }
     
-    return (assignments[employee][weekend_start_day] != 0 || 
-            assignments[employee][weekend_start_day + 1] != 0);
+    const uint64_t* row_bits = getWorkBits(employee);
+    return BitUtils::testBit(row_bits, weekend_start_day) || BitUtils::testBit(row_bits, weekend_start_day + 1);
 }
 
 // Coverage analysis
 int Schedule::getCoverage(int day, int shift_type) const {
     if (day < 0 || day >= horizon_days) return 0;
     
-    int coverage = 0;
+    if (isTrackedShift(shift_type)) {
+        return coverage[static_cast<size_t>(day) * (num_shift_types + 1) + shift_type];
+    }
+    
+    // Shift ids outside the declared range are not tracked, count them directly
+    int count = 0;
     for (int emp = 0; emp < num_employees; emp++) {
-        if (assignments[emp][day] == shift_type) {
-            coverage++;
+        if (assignments[cellIndex(emp, day)] == shift_type) {
+            count++;
         }
     }
-    return coverage;
+    return count;
 }
 
 std::vector<int> Schedule::getDailyCoverage(int day) const {
-    std::vector<int> coverage;
-    if (day < 0 || day >= horizon_days) return coverage;
+    if (day < 0 || day >= horizon_days) return std::vector<int>();
     
-    // Find max shift type to determine coverage vector size
-    int max_shift = 0;
-    for (int emp = 0; emp < num_employees; emp++) {
-        max_shift = std::max(max_shift, assignments[emp][day]);
-    }
-    
-    coverage.resize(max_shift + 1, 0);
-    for (int emp = 0; emp < num_employees; emp++) {
-        int shift = assignments[emp][day];
-        if (shift >= 0 && shift <= max_shift) {
-            coverage[shift]++;
-        }
-    }
-    
-    return coverage;
+    auto day_begin = coverage.begin() + static_cast<size_t>(day) * (num_shift_types + 1);
+    return std::vector<int>(day_begin, day_begin + num_shift_types + 1);
 }
 
 // Validation helpers
@@ -251,29 +413,14 @@ bool Schedule::isValidAssignment(int employee, int day, int shift) const {
 }
 
 bool Schedule::isEmpty() const {
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            if (assignments[i][j] != 0) {
-                return false;
-            }
-        }
-    }
-    return true;
+    return std::all_of(assignments.begin(), assignments.end(), [](int cell) { return cell == 0; });
 }
 
 // Statistics
 double Schedule::getUtilizationRate() const {
-    int total_assignments = 0;
-    int working_assignments = 0;
-    
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            total_assignments++;
-            if (assignments[i][j] != 0) {
-                working_assignments++;
-            }
-        }
-    }
+    int total_assignments = static_cast<int>(assignments.size());
+    int working_assignments = static_cast<int>(
+        std::count_if(assignments.begin(), assignments.end(), [](int cell) { return cell != 0; }));
     
     return total_assignments > 0 ? 
            static_cast<double>(working_assignments) / total_assignments : 0.0;
@@ -283,11 +430,8 @@ std::vector<int> Schedule::getWorkloadDistribution() const {
     std::vector<int> workload(num_employees, 0);
     
     for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            if (assignments[i][j] != 0) {
-                workload[i]++;
-            }
-        }
+        const Cell* row = getEmployeeRow(i);
+        workload[i] = static_cast<int>(std::count_if(row, row + horizon_days, [](int cell) { return cell != 0; }));
     }
     
     return workload;
@@ -297,6 +441,7 @@ std::vector<int> Schedule::getWorkloadDistribution() const {
 bool Schedule::operator==(const Schedule& other) const {
     return (num_employees == other.num_employees && 
             horizon_days == other.horizon_days && 
+            zobrist_hash == other.zobrist_hash &&  // Cheap reject before the full comparison
             assignments == other.assignments);
 }
 
@@ -304,17 +449,6 @@ bool Schedule::operator!=(const Schedule& other) const {
     return !(*this == other);
 }
 
-size_t Schedule::hash() const {
-    size_t hash_value = 0;
-    for (int i = 0; i < num_employees; i++) {
-        for (int j = 0; j < horizon_days; j++) {
-            hash_value ^= std::hash<int>{}(assignments[i][j]) + 0x9e3779b9 + 
-                         (hash_value << 6) + (hash_value >> 2);
-        }
-    }
-    return hash_value;
-}
-
 // Serialization
 std::string Schedule::toString() const {
     std::ostringstream oss;
@@ -323,7 +457,7 @@ std::string Schedule::toString() const {
     for (int i = 0; i < num_employees; i++) {
         oss << "Employee " << std::setw(2) << i << ": ";
         for (int j = 0; j < horizon_days; j++) {
-            oss << std::setw(2) << assignments[i][j];
+            oss << std::setw(2) << static_cast<int>(assignments[cellIndex(i, j)]);
             if (j < horizon_days - 1) oss << " ";
         }
         oss << "\n";
@@ -336,7 +470,7 @@ std::string Schedule::toCompactString() const {
     std::ostringstream oss;
     for (int i = 0; i < num_employees; i++) {
         for (int j = 0; j < horizon_days; j++) {
-            oss << assignments[i][j];
+            oss << static_cast<int>(assignments[cellIndex(i, j)]);
             if (j < horizon_days - 1) oss << ",";
         }
         if (i < num_employees - 1) oss << ";";
@@ -356,35 +490,44 @@ void Schedule::fromString(const std::string& str) {
         int day = 0;
         
         while (std::getline(day_stream, day_value, ',') && day < horizon_days) {
-            assignments[emp][day] = std::stoi(day_value);
+            assignments[cellIndex(emp, day)] = toCell(std::stoi(day_value));
             day++;
         }
         emp++;
     }
     
-    invalidateCache();
+    rebuildDerivedState();
 }
 
 // Memory management
 size_t Schedule::getMemoryFootprint() const {
-    size_t base_size = sizeof(Schedule);
-    size_t assignments_size = assignments.size() * sizeof(std::vector<int>);
-    
-    for (const auto& emp_schedule : assignments) {
-        assignments_size += emp_schedule.size() * sizeof(int);
-    }
-    
-    size_t cache_size = shift_counts.size() * sizeof(std::vector<int>) + 
-                       total_minutes.size() * sizeof(int);
-    
-    return base_size + assignments_size + cache_size;
+    // Capacity, not size: this is what the allocator actually handed out
+    return sizeof(Schedule) +
+           assignments.capacity() * sizeof(Cell) +
+           coverage.capacity() * sizeof(int) +
+           shift_counts.capacity() * sizeof(int) +
+           shift_minutes.capacity() * sizeof(int) +
+           total_minutes.capacity() * sizeof(int) +
+           work_bits.capacity() * sizeof(uint64_t);
+}
+
+size_t Schedule::estimateMemoryFootprint(int employees, int days, int shift_types) {
+    size_t cells = static_cast<size_t>(employees) * days;
+    size_t shift_slots = static_cast<size_t>(shift_types) + 1;
+    return sizeof(Schedule) +
+           cells * sizeof(Cell) +
+           static_cast<size_t>(days) * shift_slots * sizeof(int) +       // coverage
+           static_cast<size_t>(employees) * shift_slots * sizeof(int) +  // shift_counts
+           shift_slots * sizeof(int) +                                   // shift_minutes
+           static_cast<size_t>(employees) * sizeof(int) +                // total_minutes
+           static_cast<size_t>(employees) * BitUtils::wordsFor(days) * sizeof(uint64_t);
 }
 
 void Schedule::shrinkToFit() {
     assignments.shrink_to_fit();
-    for (auto& emp_schedule : assignments) {
-        emp_schedule.shrink_to_fit();
-    }
+    coverage.shrink_to_fit();
     shift_counts.shrink_to_fit();
+    shift_minutes.shrink_to_fit();
     total_minutes.shrink_to_fit();
+    work_bits.shrink_to_fit();
 }
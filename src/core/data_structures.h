@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <cstdint>
+#include <atomic>
 
 // Forward declarations
 class Instance;
@@ -78,54 +80,119 @@ struct Cover {
 
 /**
  * Represents a complete schedule solution with optimized operations
+ *
+ * Assignments are stored in a single contiguous row-major buffer of
+ * one-byte cells (employee x day), so copying a schedule is one small block
+ * copy and reading a cell is a single indexed load. A dense [day][shift] coverage table,
+ * per-employee shift counts and worked minutes are kept in sync with every
+ * assignment, so those queries are O(1) and no cache is ever rebuilt.
  */
 class Schedule {
+public:
+    // Cell storage: shift ids 0 (day off) to MAX_SHIFT_TYPES fit in one byte
+    typedef uint8_t Cell;
+    static const int MAX_SHIFT_TYPES = 255;
+    
 private:
-    std::vector<std::vector<int>> assignments;  // [employee][day] = shift_id
+    std::vector<Cell> assignments;  // [employee * horizon_days + day] = shift_id
     int num_employees;
     int horizon_days;
     int num_shift_types;
     
-    // Cached data for performance
-    mutable bool cache_valid;
-    mutable std::vector<std::unordered_map<int, int>> shift_counts;  // [employee][shift_type] = count
-    mutable std::vector<int> total_minutes;                          // [employee] = total minutes worked
+    // Incrementally maintained coverage, including shift 0 (day off)
+    std::vector<int> coverage;  // [day * (num_shift_types + 1) + shift] = employees assigned
+    
+    // Incrementally maintained per-employee counters
+    std::vector<int> shift_counts;   // [employee * (num_shift_types + 1) + shift] = days assigned
+    std::vector<int> shift_minutes;  // [shift] = duration, empty when durations are unknown
+    std::vector<int> total_minutes;  // [employee] = total minutes worked
+    
+    // Zobrist hash: XOR of cellKey(cell, shift) over all cells, updated per assignment
+    uint64_t zobrist_hash;
+    
+    // Work bitmask: bit d of an employee's row is set when day d is not a day off
+    int work_words;                  // uint64_t words per employee row
+    std::vector<uint64_t> work_bits; // [employee * work_words + day / 64]
     
     // Helper methods
-    void invalidateCache() const;
-    void updateCache() const;
-    void ensureCacheValid() const;
+    int cellIndex(int employee, int day) const { return employee * horizon_days + day; }
+    bool isInBounds(int employee, int day) const {
+        return employee >= 0 && employee < num_employees && day >= 0 && day < horizon_days;
+    }
+    bool isTrackedShift(int shift) const { return shift >= 0 && shift <= num_shift_types; }
+    void updateCoverage(int day, int old_shift, int new_shift);
+    void updateCounters(int employee, int old_shift, int new_shift);
+    void onCellChanged(int employee, int day, int old_shift, int new_shift);
+    void rebuildCoverage();
+    void rebuildCounters();
+    void rebuildHash();
+    void rebuildWorkBits();
+    void rebuildDerivedState();  // All of the above, after a bulk change of assignments
+    static uint64_t cellKey(int cell, int shift);
+    static Cell toCell(int shift);  // Throws std::out_of_range if 'shift' does not fit a Cell
+    
+    // Process-wide count of times a Schedule had to obtain fresh buffer storage
+    static std::atomic<size_t> buffer_allocations;
     
 public:
-    Schedule(int employees, int days, int shift_types);
+    Schedule(int employees, int days, int shift_types);  // Throws std::invalid_argument past MAX_SHIFT_TYPES
+    explicit Schedule(const Instance& instance);  // Sized for the instance, tracks worked minutes
     Schedule(const Schedule& other);
-    Schedule& operator=(const Schedule& other);
+    Schedule& operator=(const Schedule& other);  // Reuses this schedule's buffers when they are large enough
+    Schedule(Schedule&& other) noexcept;         // Steals the buffers; 'other' is left as an empty 0x0 schedule
+    Schedule& operator=(Schedule&& other) noexcept;
     
     // Basic assignment operations
-    void setAssignment(int employee, int day, int shift);
-    int getAssignment(int employee, int day) const;
+    void setAssignment(int employee, int day, int shift);  // Throws std::out_of_range if 'shift' does not fit a Cell
+    int getAssignment(int employee, int day) const {
+        return isInBounds(employee, day) ? assignments[cellIndex(employee, day)] : 0;  // Default to no shift
+    }
     
     // Getters
     int getNumEmployees() const { return num_employees; }
     int getHorizonDays() const { return horizon_days; }
     int getNumShiftTypes() const { return num_shift_types; }
     
+    /**
+     * Direct read access to one employee's row (horizon_days contiguous cells).
+     * The pointer is invalidated by any operation that reshapes the schedule.
+     */
+    const Cell* getEmployeeRow(int employee) const { return assignments.data() + cellIndex(employee, 0); }
+    
+    /**
+     * One employee's work bitmask (getWorkWords() words, see BitUtils).
+     * Bits at or past horizon_days are always clear.
+     */
+    const uint64_t* getWorkBits(int employee) const { return work_bits.data() + static_cast<size_t>(employee) * work_words; }
+    int getWorkWords() const { return work_words; }
+    
     // Schedule manipulation
     void randomize(int max_shifts);
     void copyFrom(const Schedule& other);
     void clear();
     void swapAssignments(int emp1, int day1, int emp2, int day2);
     
-    // Analysis methods (optimized with caching)
+    /**
+     * Enables the worked-minutes counter. Durations are indexed like
+     * Instance::getShifts(), i.e. shift_durations[shift - 1].
+     */
+    void setShiftDurations(const std::vector<int>& shift_durations);
+    bool tracksMinutes() const { return !shift_minutes.empty(); }
+    int getShiftMinutes(int shift) const {  // 0 for day off, untracked shifts or unknown durations
+        return (tracksMinutes() && isTrackedShift(shift)) ? shift_minutes[shift] : 0;
+    }
+    
+    // Analysis methods (O(1) counters maintained on every assignment)
     int getShiftCount(int employee, int shift_type) const;
-    int getTotalMinutes(int employee, const std::vector<int>& shift_durations) const;
+    int getTotalMinutes(int employee) const;  // Requires tracksMinutes(), 0 otherwise
+    int getTotalMinutes(int employee, const std::vector<int>& shift_durations) const;  // O(shift types)
     int getConsecutiveShifts(int employee, int start_day) const;
     int getConsecutiveDaysOff(int employee, int start_day) const;
     bool isWorkingWeekend(int employee, int weekend_start_day) const;
     
-    // Coverage analysis
+    // Coverage analysis (O(1) lookups into the maintained coverage table)
     int getCoverage(int day, int shift_type) const;
-    std::vector<int> getDailyCoverage(int day) const;
+    std::vector<int> getDailyCoverage(int day) const;  // indexed by shift, size num_shift_types + 1
     
     // Validation helpers
     bool isValidAssignment(int employee, int day, int shift) const;
@@ -138,15 +205,28 @@ public:
     // Comparison and hashing
     bool operator==(const Schedule& other) const;
     bool operator!=(const Schedule& other) const;
-    size_t hash() const;
+    uint64_t hash() const { return zobrist_hash; }  // O(1), equal schedules hash equal
     
     // Serialization
     std::string toString() const;
     std::string toCompactString() const;
     void fromString(const std::string& str);
     
+    // Raw row-major cells (num_employees * horizon_days bytes) for binary persistence
+    const Cell* getCells() const { return assignments.data(); }
+    void setFromCells(const Cell* cells);  // Bulk load of a full row-major grid, derived state rebuilt once
+    
     // Memory management
-    size_t getMemoryFootprint() const;
+    size_t getMemoryFootprint() const;  // Object plus the allocated capacity of every buffer
+    static size_t estimateMemoryFootprint(int employees, int days, int shift_types);  // Fresh Schedule(instance) of that shape
+    
+    /**
+     * Number of times any Schedule has allocated buffer storage: every construction
+     * or copy construction, plus copy assignments into buffers that were too small.
+     * Moves and same-shape copy assignments do not count, so a flat counter across
+     * a code region proves it recycled schedules instead of allocating new ones.
+     */
+    static size_t getBufferAllocations() { return buffer_allocations.load(std::memory_order_relaxed); }
     void shrinkToFit();
     
     // For compatibility with existing code
@@ -156,12 +236,20 @@ public:
     // Iterator support for range-based loops
     class EmployeeScheduleView {
     private:
-        const Schedule& schedule;
-        int employee_id;
+        const Cell* row;
+        int horizon_days;
     public:
-        EmployeeScheduleView(const Schedule& sched, int emp) : schedule(sched), employee_id(emp) {}
-        int operator[](int day) const { return schedule.getAssignment(employee_id, day); }
-        int size() const { return schedule.getHorizonDays(); }
+        EmployeeScheduleView(const Schedule& sched, int emp)
+            : row(nullptr), horizon_days(0) {
+            if (emp >= 0 && emp < sched.getNumEmployees()) {
+                row = sched.getEmployeeRow(emp);
+                horizon_days = sched.getHorizonDays();
+            }
+        }
+        int operator[](int day) const { return (day >= 0 && day < horizon_days) ? row[day] : 0; }
+        int size() const { return horizon_days; }
+        const Cell* begin() const { return row; }
+        const Cell* end() const { return row + horizon_days; }
     };
     
     EmployeeScheduleView getEmployeeSchedule(int employee) const {
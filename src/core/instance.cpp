@@ -1,10 +1,13 @@
 #include "instance.h"
+#include "instance_cache.h"
+#include "../utils/hash_utils.h"
 #include <iostream>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
 
 Instance::Instance() 
-    : horizon_days(0), num_employees(0), num_shift_types(0) {
+    : horizon_days(0), num_employees(0), num_shift_types(0), fingerprint(0) {
 }
 
 bool Instance::loadFromFile(const std::string& filename) {
@@ -33,12 +36,105 @@ bool Instance::loadFromFile(const std::string& filename) {
     precomputeData();
     buildLookupTables();
     
-    return isValid();
+    if (!isValid()) {
+        return false;
+    }
+    
+    // Integer view for the evaluators; fails on malformed MaxShifts entries
+    if (!compiled.build(*this)) {
+        std::cerr << "Error: Invalid MaxShifts entry in " << filename << std::endl;
+        return false;
+    }
+    profile.build(*this);
+    return true;
+}
+
+bool Instance::loadWithCache(const std::string& filename, const std::string& cache_dir) {
+    uint64_t source_hash;
+    if (!InstanceCache::hashSource(filename, source_hash)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    
+    std::string cache_path = InstanceCache::cachePath(filename, cache_dir, source_hash);
+    if (InstanceCache::load(cache_path, source_hash, *this)) {
+        profile.build(*this);  // Derived data, cheap enough not to be cached
+        return true;
+    }
+    if (!loadFromFile(filename)) {
+        return false;
+    }
+    
+    // Best effort: a cache that cannot be written only costs the next run a parse
+    InstanceCache::save(cache_path, *this, source_hash);
+    return true;
 }
 
 void Instance::precomputeData() {
     num_employees = static_cast<int>(staff_members.size());
     num_shift_types = static_cast<int>(shift_types.size());
+    
+    shift_durations.clear();
+    shift_durations.reserve(shift_types.size());
+    for (const auto& shift : shift_types) {
+        shift_durations.push_back(shift.mins);
+    }
+    
+    // Fingerprint: every section that affects the schedule shape or a hard or soft
+    // score, so archived scores are only reused for an identical instance. Lists
+    // are prefixed with their length so entries cannot shift between them.
+    fingerprint = HashUtils::FNV_OFFSET_BASIS;
+    HashUtils::hashInt(fingerprint, horizon_days);
+    HashUtils::hashInt(fingerprint, num_shift_types);
+    for (const auto& shift : shift_types) {
+        HashUtils::hashString(fingerprint, shift.ShiftID);
+        HashUtils::hashInt(fingerprint, shift.mins);
+        HashUtils::hashInt(fingerprint, static_cast<int>(shift.cant_follow.size()));
+        for (const auto& follower : shift.cant_follow) {
+            HashUtils::hashString(fingerprint, follower);
+        }
+    }
+    HashUtils::hashInt(fingerprint, num_employees);
+    for (const auto& staff : staff_members) {
+        HashUtils::hashString(fingerprint, staff.ID);
+        HashUtils::hashInt(fingerprint, static_cast<int>(staff.MaxShifts.size()));
+        for (const auto& max_shifts : staff.MaxShifts) {
+            HashUtils::hashString(fingerprint, max_shifts);
+        }
+        HashUtils::hashInt(fingerprint, staff.MaxTotalMinutes);
+        HashUtils::hashInt(fingerprint, staff.MinTotalMinutes);
+        HashUtils::hashInt(fingerprint, staff.MaxConsecutiveShifts);
+        HashUtils::hashInt(fingerprint, staff.MinConsecutiveShifts);
+        HashUtils::hashInt(fingerprint, staff.MinConsecutiveDaysOff);
+        HashUtils::hashInt(fingerprint, staff.MaxWeekends);
+    }
+    HashUtils::hashInt(fingerprint, static_cast<int>(days_off_requirements.size()));
+    for (const auto& days_off : days_off_requirements) {
+        HashUtils::hashString(fingerprint, days_off.EmployeeID);
+        HashUtils::hashInt(fingerprint, static_cast<int>(days_off.DayIndexes.size()));
+        for (const auto& day : days_off.DayIndexes) {
+            HashUtils::hashString(fingerprint, day);
+        }
+    }
+    auto hashRequests = [this](const auto& requests) {
+        HashUtils::hashInt(fingerprint, static_cast<int>(requests.size()));
+        for (const auto& request : requests) {
+            HashUtils::hashString(fingerprint, request.EmployeeID);
+            HashUtils::hashInt(fingerprint, request.Day);
+            HashUtils::hashString(fingerprint, request.ShiftID);
+            HashUtils::hashInt(fingerprint, request.Weight);
+        }
+    };
+    hashRequests(shift_on_requests);
+    hashRequests(shift_off_requests);
+    HashUtils::hashInt(fingerprint, static_cast<int>(coverage_requirements.size()));
+    for (const auto& cover : coverage_requirements) {
+        HashUtils::hashInt(fingerprint, cover.Day);
+        HashUtils::hashString(fingerprint, cover.ShiftID);
+        HashUtils::hashInt(fingerprint, cover.Requirement);
+        HashUtils::hashInt(fingerprint, cover.Weight_for_under);
+        HashUtils::hashInt(fingerprint, cover.Weight_for_over);
+    }
 }
 
 void Instance::buildLookupTables() {
@@ -137,26 +233,7 @@ bool Instance::isEmployeeAvailable(int employee_index, int day) const {
         return false;
     }
     
-    const std::string& employee_id = staff_members[employee_index].ID;
-    
-    // Check if this day is in the employee's days off
-    for (const auto& days_off : days_off_requirements) {
-        if (days_off.EmployeeID == employee_id) {
-            for (const auto& day_str : days_off.DayIndexes) {
-                try {
-                    int off_day = std::stoi(day_str);
-                    if (off_day == day) {
-                        return false;
-                    }
-                } catch (const std::exception&) {
-                    // Invalid day format, skip
-                    continue;
-                }
-            }
-        }
-    }
-    
-    return true;
+    return !compiled.isDayOff(employee_index, day);
 }
 
 int Instance::getCoverageRequirement(int day, const std::string& shift_id) const {
@@ -164,13 +241,11 @@ int Instance::getCoverageRequirement(int day, const std::string& shift_id) const
         return 0;
     }
     
-    for (const auto& cover : coverage_requirements) {
-        if (cover.Day == day && cover.ShiftID == shift_id) {
-            return cover.Requirement;
-        }
+    int shift = getShiftIndex(shift_id) + 1;
+    if (shift <= 0 || !compiled.hasCover(day, shift)) {
+        return 0; // No specific requirement found
     }
-    
-    return 0; // No specific requirement found
+    return compiled.getCoverRequirement(day, shift);
 }
 
 void Instance::printSummary() const {
@@ -195,6 +270,9 @@ void Instance::printSummary() const {
         const auto& shift = shift_types[i];
         std::cout << "  " << shift.ShiftID << " (" << shift.mins << " minutes)" << std::endl;
     }
+    
+    std::cout << "\nProfile:" << std::endl;
+    profile.print(std::cout);
 }
 
 size_t Instance::getMemoryFootprint() const {
@@ -207,6 +285,9 @@ size_t Instance::getMemoryFootprint() const {
     total += shift_on_requests.capacity() * sizeof(ShiftOnRequest);
     total += shift_off_requests.capacity() * sizeof(ShiftOffRequest);
     total += coverage_requirements.capacity() * sizeof(Cover);
+    total += shift_durations.capacity() * sizeof(int);
+    total += compiled.getMemoryFootprint() - sizeof(compiled);  // Object already counted in sizeof(*this)
+    total += profile.day_tightness.capacity() * sizeof(double);
     
     // Add hash map overhead (approximate)
     total += staff_id_to_index.size() * (sizeof(std::string) + sizeof(int) + 16); // overhead
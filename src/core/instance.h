@@ -3,6 +3,8 @@
 
 #include "data_structures.h"
 #include "instance_parser.h"
+#include "compiled_instance.h"
+#include "instance_profile.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -28,23 +30,47 @@ private:
     // Pre-computed data for faster access
     int num_employees;
     int num_shift_types;
+    std::vector<int> shift_durations;  // [shift index] = minutes, same order as shift_types
+    uint64_t fingerprint;              // Hash of every section: shape, hard limits, requests and covers
+    CompiledInstance compiled;         // Integer view for the evaluators, built after loading
+    InstanceProfile profile;           // Structural metrics, built from the compiled view
     
     // Helper methods for optimization
     void buildLookupTables();
     void precomputeData();
     
+    friend class InstanceCache;
+    
 public:
     Instance();
     ~Instance() = default;
     
     // Loading methods
     bool loadFromFile(const std::string& filename);
+    
+    /**
+     * Like loadFromFile, but goes through a binary cache keyed by the hash of
+     * the file's text (see InstanceCache). The cache lives next to the file
+     * when 'cache_dir' is empty. A missing or stale cache falls back to
+     * parsing and is then rewritten.
+     */
+    bool loadWithCache(const std::string& filename, const std::string& cache_dir = "");
     bool isValid() const;
     
     // Basic getters
     int getHorizonDays() const { return horizon_days; }
     int getNumEmployees() const { return num_employees; }
     int getNumShiftTypes() const { return num_shift_types; }
+    const std::vector<int>& getShiftDurations() const { return shift_durations; }
+    
+    // Identifies the instance (shape, hard limits, days off, requests, covers) so stored schedules and their scores can be matched to it
+    uint64_t getFingerprint() const { return fingerprint; }
+    
+    // Dense integer tables (limits, days off, requests, covers) read by the evaluators
+    const CompiledInstance& getCompiled() const { return compiled; }
+    
+    // Demand, tightness, request and rotation metrics computed at load time
+    const InstanceProfile& getProfile() const { return profile; }
     
     // Data access methods (const references for efficiency)
     const std::vector<Staff>& getStaff() const { return staff_members; }
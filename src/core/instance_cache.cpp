@@ -0,0 +1,223 @@
+#include "instance_cache.h"
+#include "instance.h"
+#include "../utils/binary_io.h"
+#include "../utils/hash_utils.h"
+#include "../utils/mapped_file.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <process.h>
+#define CACHE_PROCESS_ID _getpid()
+#else
+#include <unistd.h>
+#define CACHE_PROCESS_ID getpid()
+#endif
+
+static_assert(sizeof(InstanceCache::FileHeader) == 24, "FileHeader layout must not change within a version");
+
+bool InstanceCache::hashSource(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    hash = HashUtils::FNV_OFFSET_BASIS;
+    HashUtils::hashBytes(hash, file.data(), file.size());
+    return true;
+}
+
+std::string InstanceCache::cachePath(const std::string& source_path, const std::string& cache_dir, uint64_t source_hash) {
+    if (cache_dir.empty()) {
+        return source_path + ".nspcache";
+    }
+    size_t separator = source_path.find_last_of("/\\");
+    std::string name = separator == std::string::npos ? source_path : source_path.substr(separator + 1);
+    char hash_hex[17];
+    std::snprintf(hash_hex, sizeof(hash_hex), "%016llx", static_cast<unsigned long long>(source_hash));
+
+    std::string path = cache_dir;
+    if (path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+    return path + name + "." + hash_hex + ".nspcache";
+}
+
+bool InstanceCache::save(const std::string& path, const Instance& instance, uint64_t source_hash) {
+    BinaryWriter out;
+    out.writeInt(instance.horizon_days);
+
+    out.writeUInt32(static_cast<uint32_t>(instance.shift_types.size()));
+    for (const auto& shift : instance.shift_types) {
+        out.writeString(shift.ShiftID);
+        out.writeInt(shift.mins);
+        out.writeUInt32(static_cast<uint32_t>(shift.cant_follow.size()));
+        for (const auto& id : shift.cant_follow) out.writeString(id);
+    }
+
+    out.writeUInt32(static_cast<uint32_t>(instance.staff_members.size()));
+    for (const auto& staff : instance.staff_members) {
+        out.writeString(staff.ID);
+        out.writeUInt32(static_cast<uint32_t>(staff.MaxShifts.size()));
+        for (const auto& limit : staff.MaxShifts) out.writeString(limit);
+        out.writeInt(staff.MaxTotalMinutes);
+        out.writeInt(staff.MinTotalMinutes);
+        out.writeInt(staff.MaxConsecutiveShifts);
+        out.writeInt(staff.MinConsecutiveShifts);
+        out.writeInt(staff.MinConsecutiveDaysOff);
+        out.writeInt(staff.MaxWeekends);
+    }
+
+    out.writeUInt32(static_cast<uint32_t>(instance.days_off_requirements.size()));
+    for (const auto& days_off : instance.days_off_requirements) {
+        out.writeString(days_off.EmployeeID);
+        out.writeUInt32(static_cast<uint32_t>(days_off.DayIndexes.size()));
+        for (const auto& day : days_off.DayIndexes) out.writeString(day);
+    }
+
+    out.writeUInt32(static_cast<uint32_t>(instance.shift_on_requests.size()));
+    for (const auto& request : instance.shift_on_requests) {
+        out.writeString(request.EmployeeID);
+        out.writeInt(request.Day);
+        out.writeString(request.ShiftID);
+        out.writeInt(request.Weight);
+    }
+
+    out.writeUInt32(static_cast<uint32_t>(instance.shift_off_requests.size()));
+    for (const auto& request : instance.shift_off_requests) {
+        out.writeString(request.EmployeeID);
+        out.writeInt(request.Day);
+        out.writeString(request.ShiftID);
+        out.writeInt(request.Weight);
+    }
+
+    out.writeUInt32(static_cast<uint32_t>(instance.coverage_requirements.size()));
+    for (const auto& cover : instance.coverage_requirements) {
+        out.writeInt(cover.Day);
+        out.writeString(cover.ShiftID);
+        out.writeInt(cover.Requirement);
+        out.writeInt(cover.Weight_for_under);
+        out.writeInt(cover.Weight_for_over);
+    }
+
+    instance.compiled.save(out);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.header_size = sizeof(FileHeader);
+    header.source_hash = source_hash;
+    header.payload_size = out.data().size();
+
+    // Write under a per-process name, then rename so readers only ever see whole files
+    std::string temp_path = path + ".tmp" + std::to_string(CACHE_PROCESS_ID);
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Could not open instance cache " << temp_path << " for writing" << std::endl;
+        return false;
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (out.data().empty() || std::fwrite(out.data().data(), out.data().size(), 1, file) == 1);
+    written = (std::fclose(file) == 0) && written;
+    if (written && std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        // Windows will not rename over an existing file; replace it explicitly
+        std::remove(path.c_str());
+        written = std::rename(temp_path.c_str(), path.c_str()) == 0;
+    }
+    if (!written) {
+        std::remove(temp_path.c_str());
+        std::cerr << "Error: Failed to write instance cache " << path << std::endl;
+    }
+    return written;
+}
+
+bool InstanceCache::load(const std::string& path, uint64_t source_hash, Instance& instance) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.header_size != sizeof(FileHeader) ||
+        header.source_hash != source_hash || header.payload_size != file.size() - sizeof(FileHeader)) {
+        return false;
+    }
+
+    BinaryReader in(file.data() + sizeof(FileHeader), static_cast<size_t>(header.payload_size));
+    instance.horizon_days = in.readInt();
+
+    // Counts are checked against the remaining bytes by the reader, so a corrupt
+    // count fails on the first short read instead of allocating
+    instance.shift_types.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        Shift shift;
+        shift.ShiftID = in.readString();
+        shift.mins = in.readInt();
+        for (uint32_t j = 0, ids = in.readUInt32(); j < ids && in.ok(); j++) shift.cant_follow.push_back(in.readString());
+        instance.shift_types.push_back(std::move(shift));
+    }
+
+    instance.staff_members.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        Staff staff;
+        staff.ID = in.readString();
+        for (uint32_t j = 0, limits = in.readUInt32(); j < limits && in.ok(); j++) staff.MaxShifts.push_back(in.readString());
+        staff.MaxTotalMinutes = in.readInt();
+        staff.MinTotalMinutes = in.readInt();
+        staff.MaxConsecutiveShifts = in.readInt();
+        staff.MinConsecutiveShifts = in.readInt();
+        staff.MinConsecutiveDaysOff = in.readInt();
+        staff.MaxWeekends = in.readInt();
+        instance.staff_members.push_back(std::move(staff));
+    }
+
+    instance.days_off_requirements.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        DaysOff days_off;
+        days_off.EmployeeID = in.readString();
+        for (uint32_t j = 0, days = in.readUInt32(); j < days && in.ok(); j++) days_off.DayIndexes.push_back(in.readString());
+        instance.days_off_requirements.push_back(std::move(days_off));
+    }
+
+    instance.shift_on_requests.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        ShiftOnRequest request;
+        request.EmployeeID = in.readString();
+        request.Day = in.readInt();
+        request.ShiftID = in.readString();
+        request.Weight = in.readInt();
+        instance.shift_on_requests.push_back(std::move(request));
+    }
+
+    instance.shift_off_requests.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        ShiftOffRequest request;
+        request.EmployeeID = in.readString();
+        request.Day = in.readInt();
+        request.ShiftID = in.readString();
+        request.Weight = in.readInt();
+        instance.shift_off_requests.push_back(std::move(request));
+    }
+
+    instance.coverage_requirements.clear();
+    for (uint32_t i = 0, count = in.readUInt32(); i < count && in.ok(); i++) {
+        Cover cover;
+        cover.Day = in.readInt();
+        cover.ShiftID = in.readString();
+        cover.Requirement = in.readInt();
+        cover.Weight_for_under = in.readInt();
+        cover.Weight_for_over = in.readInt();
+        instance.coverage_requirements.push_back(std::move(cover));
+    }
+
+    if (!instance.compiled.restore(in) || !in.atEnd()) {
+        return false;
+    }
+
+    instance.precomputeData();
+    instance.buildLookupTables();
+    return instance.compiled.getNumEmployees() == instance.num_employees &&
+           instance.compiled.getHorizonDays() == instance.horizon_days &&
+           instance.compiled.getNumShiftTypes() == instance.num_shift_types;
+}
@@ -0,0 +1,53 @@
+#ifndef INSTANCE_CACHE_H
+#define INSTANCE_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+class Instance;
+
+/**
+ * Binary cache of a loaded Instance, so repeated runs on the same instance
+ * skip text parsing and table compilation.
+ *
+ * A cache file is a fixed FileHeader followed by the instance records and the
+ * CompiledInstance tables. It is keyed by the FNV-1a hash of the source text:
+ * a cache whose hash, magic or version does not match is ignored, and the
+ * caller falls back to parsing. Files are written to a temporary name and
+ * renamed into place, so concurrent runs never read a partial cache.
+ * Values are stored in native byte order.
+ */
+class InstanceCache {
+public:
+    static const uint32_t MAGIC = 0x4950534E;  // "NSPI"
+    static const uint16_t VERSION = 2;         // Bump whenever Instance or CompiledInstance data changes
+
+    struct FileHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_size;   // sizeof(FileHeader)
+        uint64_t source_hash;   // hashSource() of the text the cache was built from
+        uint64_t payload_size;  // Bytes following the header
+    };
+
+    // Hashes the contents of 'path'; returns false if it cannot be read
+    static bool hashSource(const std::string& path, uint64_t& hash);
+
+    /**
+     * Cache location for 'source_path': next to it when 'cache_dir' is empty,
+     * otherwise inside 'cache_dir' under a name that includes the content hash.
+     */
+    static std::string cachePath(const std::string& source_path, const std::string& cache_dir, uint64_t source_hash);
+
+    // Writes 'instance' to 'path'. Returns false (and reports on stderr) on failure.
+    static bool save(const std::string& path, const Instance& instance, uint64_t source_hash);
+
+    /**
+     * Maps 'path' and restores 'instance' from it. Returns false, without
+     * reporting, if the file is missing, stale (hash mismatch) or malformed;
+     * 'instance' must then be reloaded from text.
+     */
+    static bool load(const std::string& path, uint64_t source_hash, Instance& instance);
+};
+
+#endif // INSTANCE_CACHE_H
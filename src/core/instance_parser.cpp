@@ -1,11 +1,12 @@
 #include "instance_parser.h"
-#include <fstream>
+#include "../utils/mapped_file.h"
+#include <charconv>
 #include <iostream>
 
 // Section identifiers from original code
-const std::string sections[7] = {
+const std::string_view sections[7] = {
     "SECTION_HORIZON",
-    "SECTION_SHIFTS", 
+    "SECTION_SHIFTS",
     "SECTION_STAFF",
     "SECTION_DAYS_OFF",
     "SECTION_SHIFT_ON_REQUESTS",
@@ -13,141 +14,140 @@ const std::string sections[7] = {
     "SECTION_COVER"
 };
 
-std::vector<std::string> InstanceParser::tokenize(const std::string& s, const std::string& delimiter) {
-    std::vector<std::string> tokens;
+InstanceParser::InstanceParser() : line_number(0) {}
+
+std::string_view InstanceParser::trim(std::string_view s) {
+    const char* whitespace = " \t\r\n";
+    size_t start = s.find_first_not_of(whitespace);
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t end = s.find_last_not_of(whitespace);
+    return s.substr(start, end - start + 1);
+}
+
+void InstanceParser::split(std::string_view s, char delimiter, std::vector<std::string_view>& out) {
+    out.clear();
     size_t start = 0;
     size_t end = s.find(delimiter);
-    
-    while (end != std::string::npos) {
-        std::string token = s.substr(start, end - start);
-        // Trim whitespace
-        while (!token.empty() && (token.back() == ' ' || token.back() == '\r' || token.back() == '\n')) {
-            token.pop_back();
-        }
-        while (!token.empty() && (token.front() == ' ' || token.front() == '\r' || token.front() == '\n')) {
-            token.erase(0, 1);
-        }
-        tokens.push_back(token);
-        start = end + delimiter.size();
+    while (end != std::string_view::npos) {
+        out.push_back(trim(s.substr(start, end - start)));
+        start = end + 1;
         end = s.find(delimiter, start);
     }
-    
-    std::string token = s.substr(start);
-    // Trim whitespace from last token
-    while (!token.empty() && (token.back() == ' ' || token.back() == '\r' || token.back() == '\n')) {
-        token.pop_back();
-    }
-    while (!token.empty() && (token.front() == ' ' || token.front() == '\r' || token.front() == '\n')) {
-        token.erase(0, 1);
-    }
-    tokens.push_back(token);
-    return tokens;
+    out.push_back(trim(s.substr(start)));
 }
 
-std::vector<std::string> InstanceParser::cantFollow(const std::string& s, const std::string& delimiter) {
-    if (s.empty()) {
-        return std::vector<std::string>();
+bool InstanceParser::error(std::string_view at, const std::string& message) const {
+    size_t column = 1;
+    if (at.data() >= current_line.data() && at.data() <= current_line.data() + current_line.size()) {
+        column = static_cast<size_t>(at.data() - current_line.data()) + 1;
     }
-    return tokenize(s, delimiter);
+    std::cerr << "Error: " << filename << ":" << line_number << ":" << column << ": " << message << std::endl;
+    return false;
 }
 
-std::string InstanceParser::parseShift(const std::string& s, const std::string& delimiter) {
-    // This mimics the original parseShift function
-    // For "D=14" with delimiter "=", it should return "14"
-    size_t start = 0;
-    size_t end = s.find(delimiter);
-    
-    while (end != std::string::npos) {
-        start = end + delimiter.size();
-        end = s.find(delimiter, start);
+bool InstanceParser::parseInt(std::string_view field, int& value) const {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    if (field.empty() || result.ec != std::errc() || result.ptr != end) {
+        return error(field, "Expected an integer, found '" + std::string(field) + "'");
     }
-    
-    std::string result = s.substr(start);
-    return result;
+    return true;
 }
 
-std::vector<std::string> InstanceParser::maxshift(const std::string& s, const std::string& delimiter) {
-    std::vector<std::string> shiftTypes;
-    auto tokens = tokenize(s, delimiter);
-    
-    for (const auto& token : tokens) {
-        std::string shiftType = parseShift(token, "=");
-        shiftTypes.push_back(shiftType);
+bool InstanceParser::expectFields(size_t count, const char* what) const {
+    if (fields.size() < count) {
+        return error(current_line.substr(current_line.size()),
+                     std::string(what) + " needs " + std::to_string(count) + " fields, found " +
+                     std::to_string(fields.size()));
     }
-    return shiftTypes;
+    return true;
 }
 
-void InstanceParser::addShift(Shift* shift, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, delimiter);
-    
-    if (tokens.size() >= 2) {
-        shift->ShiftID = tokens[0];
-        shift->mins = std::stoi(tokens[1]);
-        
-        if (tokens.size() >= 3 && !tokens[2].empty()) {
-            shift->cant_follow = cantFollow(tokens[2], "|");
+bool InstanceParser::parseShift(Shift& shift) {
+    // ShiftID, Length in mins, Shifts which cannot follow this shift | separated
+    if (!expectFields(2, "Shift") || !parseInt(fields[1], shift.mins)) {
+        return false;
+    }
+    shift.ShiftID = std::string(fields[0]);
+
+    if (fields.size() >= 3 && !fields[2].empty()) {
+        split(fields[2], '|', subfields);
+        for (const auto& id : subfields) {
+            if (!id.empty()) {
+                shift.cant_follow.emplace_back(id);
+            }
         }
     }
+    return true;
 }
 
-void InstanceParser::addStaff(Staff* staff, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, delimiter);
-    
-    if (tokens.size() >= 8) {
-        staff->ID = tokens[0];
-        staff->MaxShifts = maxshift(tokens[1], "|");
-        staff->MaxTotalMinutes = std::stoi(tokens[2]);
-        staff->MinTotalMinutes = std::stoi(tokens[3]);
-        staff->MaxConsecutiveShifts = std::stoi(tokens[4]);
-        staff->MinConsecutiveShifts = std::stoi(tokens[5]);
-        staff->MinConsecutiveDaysOff = std::stoi(tokens[6]);
-        staff->MaxWeekends = std::stoi(tokens[7]);
+bool InstanceParser::parseStaff(Staff& staff) {
+    // ID, MaxShifts, MaxTotalMinutes, MinTotalMinutes, MaxConsecutiveShifts,
+    // MinConsecutiveShifts, MinConsecutiveDaysOff, MaxWeekends
+    if (!expectFields(8, "Staff") ||
+        !parseInt(fields[2], staff.MaxTotalMinutes) ||
+        !parseInt(fields[3], staff.MinTotalMinutes) ||
+        !parseInt(fields[4], staff.MaxConsecutiveShifts) ||
+        !parseInt(fields[5], staff.MinConsecutiveShifts) ||
+        !parseInt(fields[6], staff.MinConsecutiveDaysOff) ||
+        !parseInt(fields[7], staff.MaxWeekends)) {
+        return false;
     }
-}
+    staff.ID = std::string(fields[0]);
 
-void InstanceParser::addDaysOff(DaysOff* section, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, ",");
-    
-    if (!tokens.empty()) {
-        section->EmployeeID = tokens[0];
-        for (size_t i = 1; i < tokens.size(); i++) {
-            section->DayIndexes.push_back(tokens[i]);
+    // MaxShifts entries look like "E=14" (or "E=None"); only the limit is kept, by position
+    split(fields[1], '|', subfields);
+    for (const auto& entry : subfields) {
+        size_t separator = entry.rfind('=');
+        std::string_view limit = separator == std::string_view::npos ? entry : trim(entry.substr(separator + 1));
+        int value;
+        if (limit != "None" && !parseInt(limit, value)) {
+            return false;
         }
+        staff.MaxShifts.emplace_back(limit);
     }
+    return true;
 }
 
-void InstanceParser::addShiftOnRequest(ShiftOnRequest* section, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, ",");
-    
-    if (tokens.size() >= 4) {
-        section->EmployeeID = tokens[0];
-        section->Day = std::stoi(tokens[1]);
-        section->ShiftID = tokens[2];
-        section->Weight = std::stoi(tokens[3]);
+bool InstanceParser::parseDaysOff(DaysOff& days_off) {
+    // EmployeeID, DayIndexes (start at zero)
+    if (!expectFields(1, "Days off")) {
+        return false;
+    }
+    days_off.EmployeeID = std::string(fields[0]);
+    for (size_t i = 1; i < fields.size(); i++) {
+        int day;
+        if (!parseInt(fields[i], day)) {
+            return false;
+        }
+        days_off.DayIndexes.emplace_back(fields[i]);
     }
+    return true;
 }
 
-void InstanceParser::addShiftOffRequest(ShiftOffRequest* section, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, ",");
-    
-    if (tokens.size() >= 4) {
-        section->EmployeeID = tokens[0];
-        section->Day = std::stoi(tokens[1]);
-        section->ShiftID = tokens[2];
-        section->Weight = std::stoi(tokens[3]);
+bool InstanceParser::parseRequest(std::string& employee_id, int& day, std::string& shift_id, int& weight) {
+    // EmployeeID, Day, ShiftID, Weight
+    if (!expectFields(4, "Shift request") || !parseInt(fields[1], day) || !parseInt(fields[3], weight)) {
+        return false;
     }
+    employee_id = std::string(fields[0]);
+    shift_id = std::string(fields[2]);
+    return true;
 }
 
-void InstanceParser::addCover(Cover* section, const std::string& s, const std::string& delimiter) {
-    auto tokens = tokenize(s, ",");
-    
-    if (tokens.size() >= 5) {
-        section->Day = std::stoi(tokens[0]);
-        section->ShiftID = tokens[1];
-        section->Requirement = std::stoi(tokens[2]);
-        section->Weight_for_under = std::stoi(tokens[3]);
-        section->Weight_for_over = std::stoi(tokens[4]);
+bool InstanceParser::parseCover(Cover& cover) {
+    // Day, ShiftID, Requirement, Weight for under, Weight for over
+    if (!expectFields(5, "Cover") ||
+        !parseInt(fields[0], cover.Day) ||
+        !parseInt(fields[2], cover.Requirement) ||
+        !parseInt(fields[3], cover.Weight_for_under) ||
+        !parseInt(fields[4], cover.Weight_for_over)) {
+        return false;
     }
+    cover.ShiftID = std::string(fields[1]);
+    return true;
 }
 
 bool InstanceParser::parseInstance(const std::string& filename,
@@ -158,13 +158,15 @@ bool InstanceParser::parseInstance(const std::string& filename,
                                   std::vector<ShiftOnRequest>& shift_on_requests,
                                   std::vector<ShiftOffRequest>& shift_off_requests,
                                   std::vector<Cover>& cover_requirements) {
-    
-    std::ifstream fileStream(filename);
-    if (!fileStream.is_open()) {
+
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error: Could not open file " << filename << std::endl;
         return false;
     }
-    
+    this->filename = filename;
+    line_number = 0;
+
     // Clear all containers
     workers.clear();
     shifts.clear();
@@ -172,16 +174,30 @@ bool InstanceParser::parseInstance(const std::string& filename,
     shift_on_requests.clear();
     shift_off_requests.clear();
     cover_requirements.clear();
-    
+
+    std::string_view text(file.size() > 0 ? file.data() : "", file.size());
     bool copying = false;
     int current_section = 0;
-    std::string line;
-    
-    while (std::getline(fileStream, line)) {
-        if (line.empty() || line[0] == '#') {
+    size_t pos = 0;
+
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        current_line = text.substr(pos, end - pos);
+        pos = end + 1;
+        line_number++;
+
+        std::string_view line = trim(current_line);
+        if (line.empty()) {
+            copying = false; // A blank line ends the section
             continue;
         }
-        
+        if (line[0] == '#') {
+            continue;
+        }
+
         // Always check for section headers first
         bool is_section_header = false;
         for (int i = 0; i < 7; i++) {
@@ -192,63 +208,61 @@ bool InstanceParser::parseInstance(const std::string& filename,
                 break;
             }
         }
-        
-        if (is_section_header) {
+
+        if (is_section_header || !copying) {
             continue;
-        } else if (line.length() > 1 && copying) {
-            // Process section content
-            switch (current_section) {
-                case 0: // SECTION_HORIZON
-                    horizon = std::stoi(line);
-                    break;
-                    
-                case 1: { // SECTION_SHIFTS
-                    Shift shift;
-                    addShift(&shift, line, ",");
-                    shifts.push_back(shift);
-                    break;
-                }
-                
-                case 2: { // SECTION_STAFF
-                    Staff staff;
-                    addStaff(&staff, line, ",");
-                    workers.push_back(staff);
-                    break;
-                }
-                
-                case 3: { // SECTION_DAYS_OFF
-                    DaysOff day_off;
-                    addDaysOff(&day_off, line, ",");
-                    days_off.push_back(day_off);
-                    break;
-                }
-                
-                case 4: { // SECTION_SHIFT_ON_REQUESTS
-                    ShiftOnRequest request;
-                    addShiftOnRequest(&request, line, ",");
-                    shift_on_requests.push_back(request);
-                    break;
-                }
-                
-                case 5: { // SECTION_SHIFT_OFF_REQUESTS
-                    ShiftOffRequest request;
-                    addShiftOffRequest(&request, line, ",");
-                    shift_off_requests.push_back(request);
-                    break;
-                }
-                
-                case 6: { // SECTION_COVER
-                    Cover cover;
-                    addCover(&cover, line, ",");
-                    cover_requirements.push_back(cover);
-                    break;
-                }
+        }
+
+        // Process section content
+        split(line, ',', fields);
+        bool parsed = true;
+        switch (current_section) {
+            case 0: // SECTION_HORIZON
+                parsed = parseInt(line, horizon);
+                break;
+
+            case 1: { // SECTION_SHIFTS
+                shifts.emplace_back();
+                parsed = parseShift(shifts.back());
+                break;
+            }
+
+            case 2: { // SECTION_STAFF
+                workers.emplace_back();
+                parsed = parseStaff(workers.back());
+                break;
+            }
+
+            case 3: { // SECTION_DAYS_OFF
+                days_off.emplace_back();
+                parsed = parseDaysOff(days_off.back());
+                break;
+            }
+
+            case 4: { // SECTION_SHIFT_ON_REQUESTS
+                shift_on_requests.emplace_back();
+                ShiftOnRequest& request = shift_on_requests.back();
+                parsed = parseRequest(request.EmployeeID, request.Day, request.ShiftID, request.Weight);
+                break;
+            }
+
+            case 5: { // SECTION_SHIFT_OFF_REQUESTS
+                shift_off_requests.emplace_back();
+                ShiftOffRequest& request = shift_off_requests.back();
+                parsed = parseRequest(request.EmployeeID, request.Day, request.ShiftID, request.Weight);
+                break;
+            }
+
+            case 6: { // SECTION_COVER
+                cover_requirements.emplace_back();
+                parsed = parseCover(cover_requirements.back());
+                break;
             }
-        } else if (line.length() <= 1 && copying) {
-            copying = false;
+        }
+        if (!parsed) {
+            return false;
         }
     }
-    
-    fileStream.close();
+
     return true;
-}
\ No newline at end of file
+}
@@ -3,29 +3,49 @@
 
 #include "data_structures.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
  * Handles parsing of NSP instance files
+ *
+ * The file is memory-mapped and walked once, line by line, with fields kept
+ * as string_views into the mapping; only the ids stored in the data
+ * structures are copied. Numbers are read with from_chars, and any malformed
+ * line is reported on stderr as "file:line:column: message".
  */
 class InstanceParser {
 private:
-    // Parsing helper functions (extracted from original main.cpp)
-    std::vector<std::string> tokenize(const std::string& s, const std::string& delimiter = " ");
-    std::vector<std::string> cantFollow(const std::string& s, const std::string& delimiter = " ");
-    std::string parseShift(const std::string& s, const std::string& delimiter = " ");
-    std::vector<std::string> maxshift(const std::string& s, const std::string& delimiter = " ");
-    
-    void addShift(Shift* shift, const std::string& s, const std::string& delimiter = " ");
-    void addStaff(Staff* staff, const std::string& s, const std::string& delimiter = " ");
-    void addDaysOff(DaysOff* section, const std::string& s, const std::string& delimiter = "");
-    void addShiftOnRequest(ShiftOnRequest* section, const std::string& s, const std::string& delimiter = "");
-    void addShiftOffRequest(ShiftOffRequest* section, const std::string& s, const std::string& delimiter = "");
-    void addCover(Cover* section, const std::string& s, const std::string& delimiter = "");
-    
+    // Position of the line being parsed, for error messages
+    std::string filename;
+    int line_number;
+    std::string_view current_line;
+
+    // Field buffers reused across lines
+    std::vector<std::string_view> fields;
+    std::vector<std::string_view> subfields;
+
+    static std::string_view trim(std::string_view s);
+    static void split(std::string_view s, char delimiter, std::vector<std::string_view>& out);
+
+    // Reports an error at the column of 'at' (a view into current_line) and returns false
+    bool error(std::string_view at, const std::string& message) const;
+    bool parseInt(std::string_view field, int& value) const;
+    bool expectFields(size_t count, const char* what) const;
+
+    bool parseShift(Shift& shift);
+    bool parseStaff(Staff& staff);
+    bool parseDaysOff(DaysOff& days_off);
+    bool parseRequest(std::string& employee_id, int& day, std::string& shift_id, int& weight);
+    bool parseCover(Cover& cover);
+
 public:
+    InstanceParser();
+
     /**
-     * Parse an instance file and populate the data structures
+     * Parse an instance file and populate the data structures.
+     * Returns false (and reports the first error on stderr) if the file cannot
+     * be read or a line is malformed.
      */
     bool parseInstance(const std::string& filename,
                       int& horizon,
@@ -37,4 +57,4 @@ public:
                       std::vector<Cover>& cover_requirements);
 };
 
-#endif // INSTANCE_PARSER_H
\ No newline at end of file
+#endif // INSTANCE_PARSER_H
@@ -0,0 +1,123 @@
+#include "instance_profile.h"
+#include "instance.h"
+#include <algorithm>
+#include <cmath>
+
+InstanceProfile::InstanceProfile()
+    : num_employees(0), horizon_days(0), num_shift_types(0), num_cells(0),
+      demand_minutes(0), demand_assignments(0), max_capacity_minutes(0), min_capacity_minutes(0),
+      demand_capacity_ratio(0.0), mean_day_tightness(0.0), max_day_tightness(0.0), tightest_day(-1),
+      num_requests(0), request_density(0.0), mean_request_weight(0.0), mean_cover_weight(0.0),
+      forbidden_transitions(0), rotation_density(0.0), frozen_cells(0), frozen_share(0.0) {}
+
+void InstanceProfile::build(const Instance& instance) {
+    const CompiledInstance& compiled = instance.getCompiled();
+    num_employees = instance.getNumEmployees();
+    horizon_days = instance.getHorizonDays();
+    num_shift_types = instance.getNumShiftTypes();
+    num_cells = num_employees * horizon_days;
+
+    max_capacity_minutes = 0;
+    min_capacity_minutes = 0;
+    for (int emp = 0; emp < num_employees; emp++) {
+        max_capacity_minutes += compiled.getLimits(emp).max_total_minutes;
+        min_capacity_minutes += compiled.getLimits(emp).min_total_minutes;
+    }
+
+    // Demand and per-day tightness from the dense cover table
+    demand_minutes = 0;
+    demand_assignments = 0;
+    int64_t cover_weight_sum = 0;
+    int num_covers = 0;
+    frozen_cells = 0;
+    day_tightness.assign(horizon_days, 0.0);
+    mean_day_tightness = 0.0;
+    max_day_tightness = 0.0;
+    tightest_day = -1;
+    for (int day = 0; day < horizon_days; day++) {
+        int required = 0;
+        for (int shift = 1; shift <= num_shift_types; shift++) {
+            if (!compiled.hasCover(day, shift)) continue;
+            int requirement = compiled.getCoverRequirement(day, shift);
+            required += requirement;
+            demand_minutes += static_cast<int64_t>(requirement) * instance.getShiftDurations()[shift - 1];
+            cover_weight_sum += compiled.getCoverWeightUnder(day, shift) + compiled.getCoverWeightOver(day, shift);
+            num_covers++;
+        }
+        demand_assignments += required;
+
+        int available = 0;
+        for (int emp = 0; emp < num_employees; emp++) {
+            if (compiled.isDayOff(emp, day)) {
+                frozen_cells++;
+            } else {
+                available++;
+            }
+        }
+        day_tightness[day] = static_cast<double>(required) / std::max(available, 1);
+        mean_day_tightness += day_tightness[day];
+        if (tightest_day < 0 || day_tightness[day] > max_day_tightness) {
+            max_day_tightness = day_tightness[day];
+            tightest_day = day;
+        }
+    }
+    if (horizon_days > 0) {
+        mean_day_tightness /= horizon_days;
+    }
+    demand_capacity_ratio = max_capacity_minutes > 0 ?
+        static_cast<double>(demand_minutes) / max_capacity_minutes : 0.0;
+    mean_cover_weight = num_covers > 0 ? static_cast<double>(cover_weight_sum) / (2.0 * num_covers) : 0.0;
+
+    // Requests are counted as written, so duplicates count twice, as they do in the score
+    int64_t request_weight_sum = 0;
+    for (const auto& request : instance.getShiftOnRequests()) request_weight_sum += request.Weight;
+    for (const auto& request : instance.getShiftOffRequests()) request_weight_sum += request.Weight;
+    num_requests = static_cast<int>(instance.getShiftOnRequests().size() + instance.getShiftOffRequests().size());
+    request_density = num_cells > 0 ? static_cast<double>(num_requests) / num_cells : 0.0;
+    mean_request_weight = num_requests > 0 ? static_cast<double>(request_weight_sum) / num_requests : 0.0;
+
+    forbidden_transitions = 0;
+    for (int prev = 1; prev <= num_shift_types; prev++) {
+        for (int next = 1; next <= num_shift_types; next++) {
+            forbidden_transitions += compiled.isForbiddenTransition(prev, next) ? 1 : 0;
+        }
+    }
+    rotation_density = num_shift_types > 0 ?
+        static_cast<double>(forbidden_transitions) / (num_shift_types * num_shift_types) : 0.0;
+
+    frozen_share = num_cells > 0 ? static_cast<double>(frozen_cells) / num_cells : 0.0;
+}
+
+InstanceProfile::SuggestedParameters InstanceProfile::suggestParameters() const {
+    SuggestedParameters parameters;
+
+    // exp(-w / T) = 1/2 for the typical penalty w; tight days need more uphill moves early on
+    double typical_penalty = std::max({mean_request_weight, mean_cover_weight, 1.0});
+    parameters.initial_temp = typical_penalty / std::log(2.0) * (1.0 + mean_day_tightness);
+    parameters.stagnation_limit = std::max(500, num_cells);
+    return parameters;
+}
+
+void InstanceProfile::print(std::ostream& out) const {
+    SuggestedParameters parameters = suggestParameters();
+    out << "employees: " << num_employees << "\n"
+        << "horizon_days: " << horizon_days << "\n"
+        << "shift_types: " << num_shift_types << "\n"
+        << "demand_minutes: " << demand_minutes << "\n"
+        << "demand_assignments: " << demand_assignments << "\n"
+        << "max_capacity_minutes: " << max_capacity_minutes << "\n"
+        << "min_capacity_minutes: " << min_capacity_minutes << "\n"
+        << "demand_capacity_ratio: " << demand_capacity_ratio << "\n"
+        << "mean_day_tightness: " << mean_day_tightness << "\n"
+        << "max_day_tightness: " << max_day_tightness << " (day " << tightest_day << ")\n"
+        << "requests: " << num_requests << "\n"
+        << "request_density: " << request_density << "\n"
+        << "mean_request_weight: " << mean_request_weight << "\n"
+        << "mean_cover_weight: " << mean_cover_weight << "\n"
+        << "forbidden_transitions: " << forbidden_transitions << "\n"
+        << "rotation_density: " << rotation_density << "\n"
+        << "frozen_cells: " << frozen_cells << "\n"
+        << "frozen_share: " << frozen_share << "\n"
+        << "suggested_initial_temp: " << parameters.initial_temp << "\n"
+        << "suggested_stagnation_limit: " << parameters.stagnation_limit << "\n";
+}
@@ -0,0 +1,71 @@
+#ifndef INSTANCE_PROFILE_H
+#define INSTANCE_PROFILE_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class Instance;
+
+/**
+ * Structural metrics of an Instance, computed once at load time from the
+ * CompiledInstance tables, that say how hard the instance is and how the
+ * solver should be tuned for it.
+ *
+ * Demand is what the cover requirements ask for; capacity is what the staff
+ * limits allow. Tightness of a day is the staff it requires over the staff
+ * not on a pre-assigned day off. Shares and densities are in [0, 1].
+ */
+struct InstanceProfile {
+    // Starting parameters for SimulatedAnnealing derived from the profile
+    struct SuggestedParameters {
+        double initial_temp;
+        int stagnation_limit;
+    };
+
+    int num_employees;
+    int horizon_days;
+    int num_shift_types;
+    int num_cells;  // employees * days
+
+    // Workload: demand vs. what the MaxTotalMinutes / MinTotalMinutes limits allow
+    int64_t demand_minutes;        // Sum of requirement * shift length over covers
+    int64_t demand_assignments;    // Sum of cover requirements
+    int64_t max_capacity_minutes;  // Sum of MaxTotalMinutes
+    int64_t min_capacity_minutes;  // Sum of MinTotalMinutes
+    double demand_capacity_ratio;  // demand_minutes / max_capacity_minutes
+
+    // Coverage tightness per day: required staff / staff not frozen on that day
+    std::vector<double> day_tightness;  // [day]
+    double mean_day_tightness;
+    double max_day_tightness;
+    int tightest_day;
+
+    // Requests and rotation rules
+    int num_requests;                // Shift-on plus shift-off requests
+    double request_density;          // num_requests / num_cells
+    double mean_request_weight;
+    double mean_cover_weight;        // Mean of the under and over weights of all covers
+    int forbidden_transitions;       // Forbidden (prev, next) pairs
+    double rotation_density;         // forbidden_transitions / num_shift_types^2
+
+    // Pre-assigned days off (frozen cells)
+    int frozen_cells;
+    double frozen_share;             // frozen_cells / num_cells
+
+    InstanceProfile();
+
+    void build(const Instance& instance);
+
+    /**
+     * Heuristic starting point, not a tuned optimum: the initial temperature
+     * accepts an uphill move of typical penalty with probability 1/2, scaled
+     * up on tight days; the stagnation limit grows with the number of cells.
+     */
+    SuggestedParameters suggestParameters() const;
+
+    // One "name: value" line per metric
+    void print(std::ostream& out) const;
+};
+
+#endif // INSTANCE_PROFILE_H
@@ -0,0 +1,65 @@
+#include "run_index.h"
+#include "../utils/bit_utils.h"
+#include <algorithm>
+
+std::atomic<size_t> RunIndex::buffer_allocations(0);
+
+RunIndex::RunIndex() : num_employees(0), horizon_days(0), row_words(0) {}
+
+RunIndex::RunIndex(const Schedule& schedule) : num_employees(0), horizon_days(0), row_words(0) {
+    rebuild(schedule);
+}
+
+void RunIndex::rebuild(const Schedule& schedule) {
+    num_employees = schedule.getNumEmployees();
+    horizon_days = schedule.getHorizonDays();
+    row_words = BitUtils::wordsFor(horizon_days);
+
+    size_t words = static_cast<size_t>(num_employees) * row_words;
+    if (work_bits.capacity() < words) {
+        buffer_allocations++;
+    }
+    work_bits.resize(words);
+    for (int emp = 0; emp < num_employees; emp++) {
+        const uint64_t* bits = schedule.getWorkBits(emp);
+        std::copy(bits, bits + row_words, row(emp));
+    }
+}
+
+void RunIndex::update(int employee, int day, bool working) {
+    if (employee < 0 || employee >= num_employees || day < 0 || day >= horizon_days) {
+        return;
+    }
+    if (working) {
+        BitUtils::setBit(row(employee), day);
+    } else {
+        BitUtils::clearBit(row(employee), day);
+    }
+}
+
+RunIndex::Run RunIndex::runContaining(int employee, int day) const {
+    const uint64_t* bits = row(employee);
+    bool working = BitUtils::testBit(bits, day);
+    if (working) {
+        return {BitUtils::prevClearBit(bits, day) + 1, BitUtils::nextClearBit(bits, day, horizon_days), true};
+    }
+    return {BitUtils::prevSetBit(bits, day) + 1, BitUtils::nextSetBit(bits, day, horizon_days), false};
+}
+
+int RunIndex::getNumRuns(int employee) const {
+    int count = 0;
+    for (int start = 0; start < horizon_days; start = runContaining(employee, start).end) {
+        count++;
+    }
+    return count;
+}
+
+std::vector<RunIndex::Run> RunIndex::getRuns(int employee) const {
+    std::vector<Run> result;
+    for (int start = 0; start < horizon_days;) {
+        Run run = runContaining(employee, start);
+        result.push_back(run);
+        start = run.end;
+    }
+    return result;
+}
@@ -0,0 +1,73 @@
+#ifndef RUN_INDEX_H
+#define RUN_INDEX_H
+
+#include "data_structures.h"
+#include <atomic>
+#include <vector>
+
+/**
+ * Index of the maximal work and rest runs of every employee.
+ *
+ * Each employee's row is kept as a work bitmask (bit d set when day d is
+ * worked), laid out like Schedule's. A run is a maximal stretch of equal
+ * bits, so "run containing day d" is one backward and one forward scan for
+ * the opposite bit, whole words at a time: O(horizon / 64), a single word
+ * for any realistic horizon. Flipping a day is a single bit operation and
+ * never touches the allocator; storage is only (re)sized by rebuild().
+ *
+ * The index only follows the work/off status of each cell; it is kept in
+ * sync by its owner (IncrementalEvaluator) as moves are applied.
+ */
+class RunIndex {
+public:
+    struct Run {
+        int start;    // First day of the run
+        int end;      // One past the last day
+        bool working; // Worked run (true) or rest run (false)
+
+        int length() const { return end - start; }
+    };
+
+private:
+    int num_employees;
+    int horizon_days;
+    int row_words;                   // uint64_t words per employee row
+    std::vector<uint64_t> work_bits; // [employee * row_words + day / 64]
+
+    // Process-wide count of times rebuild() had to grow the bitmask storage
+    static std::atomic<size_t> buffer_allocations;
+
+    const uint64_t* row(int employee) const { return work_bits.data() + static_cast<size_t>(employee) * row_words; }
+    uint64_t* row(int employee) { return work_bits.data() + static_cast<size_t>(employee) * row_words; }
+
+public:
+    RunIndex();
+    explicit RunIndex(const Schedule& schedule);
+
+    // Rebuilds every employee's runs from the schedule's work bitmask
+    void rebuild(const Schedule& schedule);
+
+    /**
+     * Records that 'day' of 'employee' is now worked or off.
+     * No-op when the status does not change.
+     */
+    void update(int employee, int day, bool working);
+
+    // Run containing 'day' (which must lie in the horizon)
+    Run runContaining(int employee, int day) const;
+
+    int getNumRuns(int employee) const;
+    int getHorizonDays() const { return horizon_days; }
+
+    // All runs of one employee in day order
+    std::vector<Run> getRuns(int employee) const;
+
+    /**
+     * Number of times any RunIndex had to obtain fresh bitmask storage. Only
+     * a rebuild() for a larger schedule counts; updates never allocate, so the
+     * counter stays flat across a search loop that applies moves.
+     */
+    static size_t getBufferAllocations() { return buffer_allocations.load(std::memory_order_relaxed); }
+};
+
+#endif // RUN_INDEX_H
@@ -0,0 +1,135 @@
+#include "schedule_archive.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+static_assert(sizeof(ScheduleArchive::RecordHeader) == 64, "RecordHeader layout must not change within a version");
+
+size_t ScheduleArchive::paddedPayloadSize(uint64_t payload_size) {
+    return static_cast<size_t>((payload_size + 7) & ~uint64_t(7));
+}
+
+bool ScheduleArchive::append(const std::string& path, const Instance& instance, const std::vector<Entry>& entries) {
+    size_t total_size = 0;
+    for (const auto& entry : entries) {
+        const Schedule& schedule = *entry.schedule;
+        uint64_t payload = static_cast<uint64_t>(schedule.getNumEmployees()) * schedule.getHorizonDays();
+        total_size += sizeof(RecordHeader) + paddedPayloadSize(payload * sizeof(Schedule::Cell));
+    }
+
+    // Whole batch in one zero-initialized buffer, padding included
+    std::vector<char> buffer(total_size, 0);
+    size_t offset = 0;
+    for (const auto& entry : entries) {
+        const Schedule& schedule = *entry.schedule;
+        RecordHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.header_size = sizeof(RecordHeader);
+        header.instance_fingerprint = instance.getFingerprint();
+        header.num_employees = schedule.getNumEmployees();
+        header.horizon_days = schedule.getHorizonDays();
+        header.num_shift_types = schedule.getNumShiftTypes();
+        header.cell_size = sizeof(Schedule::Cell);
+        header.hard_score = entry.hard_score;
+        header.soft_score = entry.soft_score;
+        header.schedule_hash = schedule.hash();
+        header.payload_size = static_cast<uint64_t>(schedule.getNumEmployees()) * schedule.getHorizonDays() *
+                              sizeof(Schedule::Cell);
+
+        std::memcpy(buffer.data() + offset, &header, sizeof(header));
+        if (header.payload_size > 0) {
+            std::memcpy(buffer.data() + offset + sizeof(header), schedule.getCells(), header.payload_size);
+        }
+        offset += sizeof(header) + paddedPayloadSize(header.payload_size);
+    }
+
+    std::FILE* out = std::fopen(path.c_str(), "ab");
+    if (!out) {
+        std::cerr << "Error: Could not open archive " << path << " for writing" << std::endl;
+        return false;
+    }
+    std::setvbuf(out, nullptr, _IONBF, 0);  // Unbuffered: the batch goes out as one write
+    bool written = buffer.empty() || std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    written = (std::fclose(out) == 0) && written;
+    if (!written) {
+        std::cerr << "Error: Failed to write archive " << path << std::endl;
+    }
+    return written;
+}
+
+bool ScheduleArchive::append(const std::string& path, const Instance& instance, const Schedule& schedule,
+                             Score hard_score, Score soft_score) {
+    return append(path, instance, std::vector<Entry>{{&schedule, hard_score, soft_score}});
+}
+
+bool ScheduleArchive::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        std::cerr << "Error: Could not map archive " << path << std::endl;
+        return false;
+    }
+
+    size_t offset = 0;
+    while (offset < file.size()) {
+        if (file.size() - offset < sizeof(RecordHeader)) {
+            std::cerr << "Error: Truncated record header at byte " << offset << " of " << path << std::endl;
+            close();
+            return false;
+        }
+        RecordHeader header;
+        std::memcpy(&header, file.data() + offset, sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION || header.header_size != sizeof(RecordHeader) ||
+            header.cell_size != sizeof(Schedule::Cell)) {
+            std::cerr << "Error: Unsupported or corrupt record at byte " << offset << " of " << path << std::endl;
+            close();
+            return false;
+        }
+        uint64_t expected_payload = static_cast<uint64_t>(header.num_employees) * header.horizon_days *
+                                    sizeof(Schedule::Cell);
+        if (header.num_employees < 0 || header.horizon_days < 0 || header.payload_size != expected_payload ||
+            paddedPayloadSize(header.payload_size) > file.size() - offset - sizeof(RecordHeader)) {
+            std::cerr << "Error: Truncated or inconsistent record at byte " << offset << " of " << path << std::endl;
+            close();
+            return false;
+        }
+        record_offsets.push_back(offset);
+        offset += sizeof(RecordHeader) + paddedPayloadSize(header.payload_size);
+    }
+    return true;
+}
+
+void ScheduleArchive::close() {
+    file.close();
+    record_offsets.clear();
+}
+
+const ScheduleArchive::RecordHeader& ScheduleArchive::getHeader(size_t index) const {
+    // Records start 8-byte aligned within a page-aligned mapping
+    return *reinterpret_cast<const RecordHeader*>(file.data() + record_offsets.at(index));
+}
+
+const Schedule::Cell* ScheduleArchive::getCells(size_t index) const {
+    return reinterpret_cast<const Schedule::Cell*>(file.data() + record_offsets.at(index) + sizeof(RecordHeader));
+}
+
+bool ScheduleArchive::matches(size_t index, const Instance& instance) const {
+    const RecordHeader& header = getHeader(index);
+    return header.instance_fingerprint == instance.getFingerprint() &&
+           header.num_employees == instance.getNumEmployees() &&
+           header.horizon_days == instance.getHorizonDays() &&
+           header.num_shift_types == instance.getNumShiftTypes();
+}
+
+bool ScheduleArchive::load(size_t index, const Instance& instance, Schedule& schedule) const {
+    const RecordHeader& header = getHeader(index);
+    if (!matches(index, instance) ||
+        schedule.getNumEmployees() != header.num_employees ||
+        schedule.getHorizonDays() != header.horizon_days ||
+        schedule.getNumShiftTypes() != header.num_shift_types) {
+        return false;
+    }
+    schedule.setFromCells(getCells(index));
+    return schedule.hash() == header.schedule_hash;
+}
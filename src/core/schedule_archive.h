@@ -0,0 +1,88 @@
+#ifndef SCHEDULE_ARCHIVE_H
+#define SCHEDULE_ARCHIVE_H
+
+#include "data_structures.h"
+#include "instance.h"
+#include "score.h"
+#include "../utils/mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Versioned binary archive of schedules, used to checkpoint elite solutions
+ * and reload them for warm starts without going through text.
+ *
+ * An archive is a plain concatenation of records, so appending never touches
+ * existing data. Each record is a fixed 64-byte RecordHeader followed by the
+ * schedule's row-major cells, zero-padded to a multiple of 8 bytes so every
+ * header stays aligned. Values are stored in native byte order.
+ *
+ * Writing builds all records in one buffer and issues a single unbuffered
+ * write. Reading maps the file and indexes the headers; cells are exposed
+ * in place and copied into a Schedule only by load().
+ */
+class ScheduleArchive {
+public:
+    static const uint32_t MAGIC = 0x5350534E;  // "NSPS"
+    static const uint16_t VERSION = 2;  // 2: scores are int64 Score instead of double
+
+    struct RecordHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_size;           // sizeof(RecordHeader), for forward compatibility
+        uint64_t instance_fingerprint;  // Instance::getFingerprint() of the instance solved
+        int32_t num_employees;
+        int32_t horizon_days;
+        int32_t num_shift_types;
+        uint32_t cell_size;             // sizeof(Schedule::Cell)
+        Score hard_score;
+        Score soft_score;
+        uint64_t schedule_hash;         // Schedule::hash(), verified on load
+        uint64_t payload_size;          // Cell bytes, excluding padding
+    };
+
+    struct Entry {
+        const Schedule* schedule;
+        Score hard_score;
+        Score soft_score;
+    };
+
+private:
+    MappedFile file;
+    std::vector<size_t> record_offsets;
+
+    static size_t paddedPayloadSize(uint64_t payload_size);
+
+public:
+    /**
+     * Appends one record per entry to 'path', creating the file if needed.
+     * Returns false (and reports on stderr) if the file cannot be written.
+     */
+    static bool append(const std::string& path, const Instance& instance, const std::vector<Entry>& entries);
+    static bool append(const std::string& path, const Instance& instance, const Schedule& schedule,
+                       Score hard_score, Score soft_score);
+
+    /**
+     * Maps an archive and indexes its records. Returns false (and reports on
+     * stderr) if the file is missing or any record is malformed or truncated.
+     */
+    bool open(const std::string& path);
+    void close();
+
+    size_t size() const { return record_offsets.size(); }
+    const RecordHeader& getHeader(size_t index) const;
+    const Schedule::Cell* getCells(size_t index) const;  // Points into the mapping
+
+    // True if record 'index' was written for this instance
+    bool matches(size_t index, const Instance& instance) const;
+
+    /**
+     * Copies record 'index' into 'schedule', which must have the record's shape.
+     * Returns false if the record does not match the instance or the schedule,
+     * or if the loaded cells do not reproduce the stored hash.
+     */
+    bool load(size_t index, const Instance& instance, Schedule& schedule) const;
+};
+
+#endif // SCHEDULE_ARCHIVE_H
@@ -0,0 +1,46 @@
+#include "schedule_pool.h"
+#include <utility>
+
+SchedulePool::SchedulePool(const Instance& instance) : instance(instance), buffers_created(0) {}
+
+bool SchedulePool::hasInstanceShape(const Schedule& schedule) const {
+    return schedule.getNumEmployees() == instance.getNumEmployees() &&
+           schedule.getHorizonDays() == instance.getHorizonDays() &&
+           schedule.getNumShiftTypes() == instance.getNumShiftTypes();
+}
+
+Schedule SchedulePool::acquire() {
+    if (free_list.empty()) {
+        buffers_created++;
+        return Schedule(instance);
+    }
+    Schedule schedule = std::move(free_list.back());
+    free_list.pop_back();
+    schedule.clear();
+    return schedule;
+}
+
+Schedule SchedulePool::acquire(const Schedule& source) {
+    if (free_list.empty()) {
+        buffers_created++;
+        return Schedule(source);
+    }
+    Schedule schedule = std::move(free_list.back());
+    free_list.pop_back();
+    schedule = source;
+    return schedule;
+}
+
+void SchedulePool::release(Schedule&& schedule) {
+    if (hasInstanceShape(schedule)) {
+        free_list.push_back(std::move(schedule));
+    }
+}
+
+void SchedulePool::reserve(size_t count) {
+    free_list.reserve(count);
+    while (free_list.size() < count) {
+        buffers_created++;
+        free_list.emplace_back(instance);
+    }
+}
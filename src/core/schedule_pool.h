@@ -0,0 +1,48 @@
+#ifndef SCHEDULE_POOL_H
+#define SCHEDULE_POOL_H
+
+#include "data_structures.h"
+#include "instance.h"
+#include <vector>
+
+/**
+ * Free list of Schedule buffers shaped for one instance.
+ *
+ * Solvers acquire working schedules from the pool and release them when done
+ * instead of constructing and destroying them. A released schedule keeps its
+ * buffers, so the next acquire(source) is a copy into storage that already
+ * has the right size and never touches the allocator. Once the pool holds as
+ * many buffers as the solver uses at its peak, Schedule::getBufferAllocations()
+ * stays flat.
+ *
+ * Schedules are handed out and returned by value; with Schedule's move
+ * operations that only transfers buffer ownership.
+ */
+class SchedulePool {
+private:
+    const Instance& instance;
+    std::vector<Schedule> free_list;
+    size_t buffers_created;
+
+    bool hasInstanceShape(const Schedule& schedule) const;
+
+public:
+    explicit SchedulePool(const Instance& instance);
+
+    // Empty schedule (every cell a day off) of the instance's shape
+    Schedule acquire();
+
+    // Copy of 'source' in a recycled buffer
+    Schedule acquire(const Schedule& source);
+
+    // Returns a buffer to the pool; schedules of another shape are simply dropped
+    void release(Schedule&& schedule);
+
+    // Pre-allocates buffers until at least 'count' are available
+    void reserve(size_t count);
+
+    size_t available() const { return free_list.size(); }
+    size_t getBuffersCreated() const { return buffers_created; }
+};
+
+#endif // SCHEDULE_POOL_H
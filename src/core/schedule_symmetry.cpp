@@ -0,0 +1,101 @@
+#include "schedule_symmetry.h"
+#include "../utils/hash_utils.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+uint64_t ScheduleSymmetry::canonicalHash(const Schedule& schedule, const CompiledInstance& compiled) {
+    // Each row is hashed with its class id, then rows are summed: addition is
+    // order-independent, so permuting rows inside a class keeps the hash
+    int days = schedule.getHorizonDays();
+    uint64_t hash = 0;
+    for (int emp = 0; emp < schedule.getNumEmployees(); emp++) {
+        uint64_t row_hash = HashUtils::FNV_OFFSET_BASIS;
+        HashUtils::hashInt(row_hash, compiled.getEmployeeClass(emp));
+        HashUtils::hashBytes(row_hash, schedule.getEmployeeRow(emp), days);
+
+        // splitmix64 finalizer, so sums of similar rows do not cancel out
+        row_hash = (row_hash ^ (row_hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        row_hash = (row_hash ^ (row_hash >> 27)) * 0x94d049bb133111ebULL;
+        hash += row_hash ^ (row_hash >> 31);
+    }
+    return hash;
+}
+
+bool ScheduleSymmetry::equivalent(const Schedule& a, const Schedule& b, const CompiledInstance& compiled) {
+    if (a == b) {
+        return true;
+    }
+    if (a.getNumEmployees() != b.getNumEmployees() || a.getHorizonDays() != b.getHorizonDays() ||
+        canonicalHash(a, compiled) != canonicalHash(b, compiled)) {
+        return false;
+    }
+
+    // Same multiset of rows in every class: sort (class, row) for both schedules and compare
+    int days = a.getHorizonDays();
+    auto sortedRows = [&](const Schedule& schedule) {
+        std::vector<std::pair<int, const Schedule::Cell*>> rows;
+        rows.reserve(schedule.getNumEmployees());
+        for (int emp = 0; emp < schedule.getNumEmployees(); emp++) {
+            rows.emplace_back(compiled.getEmployeeClass(emp), schedule.getEmployeeRow(emp));
+        }
+        std::sort(rows.begin(), rows.end(), [days](const auto& x, const auto& y) {
+            return x.first != y.first ? x.first < y.first : std::memcmp(x.second, y.second, days) < 0;
+        });
+        return rows;
+    };
+    std::vector<std::pair<int, const Schedule::Cell*>> rows_a = sortedRows(a);
+    std::vector<std::pair<int, const Schedule::Cell*>> rows_b = sortedRows(b);
+    for (size_t i = 0; i < rows_a.size(); i++) {
+        if (rows_a[i].first != rows_b[i].first || std::memcmp(rows_a[i].second, rows_b[i].second, days) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ScheduleSymmetry::isNeutralMove(const Schedule& schedule, const Move& move, const CompiledInstance& compiled) {
+    switch (move.type) {
+        case MoveType::Change:
+        case MoveType::FixShiftRotation:
+            return schedule.getAssignment(move.employee1, move.day1) == move.shift2;
+        case MoveType::Swap:
+            if (schedule.getAssignment(move.employee1, move.day1) == schedule.getAssignment(move.employee2, move.day2)) {
+                return true;
+            }
+            return move.day1 == move.day2 &&
+                   isNeutralExchange(schedule, move.employee1, move.employee2, move.day1, move.day1, compiled);
+        case MoveType::BlockSwap:
+            return isNeutralExchange(schedule, move.employee1, move.employee2,
+                                     move.day1, move.day1 + move.block_size - 1, compiled);
+        default:
+            return false;
+    }
+}
+
+bool ScheduleSymmetry::isNeutralExchange(const Schedule& schedule, int employee1, int employee2,
+                                         int first_day, int last_day, const CompiledInstance& compiled) {
+    if (employee1 == employee2) {
+        return true;
+    }
+    const Schedule::Cell* row1 = schedule.getEmployeeRow(employee1);
+    const Schedule::Cell* row2 = schedule.getEmployeeRow(employee2);
+
+    bool changes_cells = false;
+    bool same_contract = compiled.getContractClass(employee1) == compiled.getContractClass(employee2);
+    for (int day = first_day; day <= last_day; day++) {
+        if (row1[day] == row2[day]) continue;
+        changes_cells = true;
+        if (!same_contract || compiled.getDayPattern(employee1, day) != compiled.getDayPattern(employee2, day)) {
+            return false;
+        }
+    }
+    if (!changes_cells) {
+        return true;
+    }
+
+    // The rows must be swapped whole: equal outside the exchanged days
+    int days = schedule.getHorizonDays();
+    return std::memcmp(row1, row2, first_day) == 0 &&
+           std::memcmp(row1 + last_day + 1, row2 + last_day + 1, days - last_day - 1) == 0;
+}
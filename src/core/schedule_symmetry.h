@@ -0,0 +1,45 @@
+#ifndef SCHEDULE_SYMMETRY_H
+#define SCHEDULE_SYMMETRY_H
+
+#include "data_structures.h"
+#include "compiled_instance.h"
+#include "move.h"
+#include <cstdint>
+
+/**
+ * Schedule operations modulo the employee equivalence classes of a
+ * CompiledInstance (see CompiledInstance::getEmployeeClass).
+ *
+ * Permuting the rows of employees in the same employee class gives a
+ * schedule with exactly the same scores; such schedules are treated as one
+ * state by the elite pool and the tabu memory. Moves whose only effect is
+ * such a permutation, or no effect at all, are neutral and need no
+ * evaluation.
+ */
+class ScheduleSymmetry {
+public:
+    /**
+     * Hash that is equal for schedules that differ only by permuting rows
+     * within employee classes. O(employees * days).
+     */
+    static uint64_t canonicalHash(const Schedule& schedule, const CompiledInstance& compiled);
+
+    // True when 'a' and 'b' are equal up to permuting rows within employee classes
+    static bool equivalent(const Schedule& a, const Schedule& b, const CompiledInstance& compiled);
+
+    /**
+     * True when applying 'move' to 'schedule' provably leaves every hard and
+     * soft score unchanged: it changes no cell, or it only exchanges cells of
+     * two employees in the same contract class, their rows end up swapped,
+     * and they share the day pattern on every exchanged day that differs.
+     * O(days) at worst; O(1) for employees in different contract classes.
+     */
+    static bool isNeutralMove(const Schedule& schedule, const Move& move, const CompiledInstance& compiled);
+
+private:
+    // Same-day exchange of days [first_day, last_day] between two employees
+    static bool isNeutralExchange(const Schedule& schedule, int employee1, int employee2,
+                                  int first_day, int last_day, const CompiledInstance& compiled);
+};
+
+#endif // SCHEDULE_SYMMETRY_H
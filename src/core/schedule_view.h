@@ -0,0 +1,162 @@
+#ifndef SCHEDULE_VIEW_H
+#define SCHEDULE_VIEW_H
+
+#include "data_structures.h"
+#include "../utils/bit_utils.h"
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Read-only what-if overlay over a Schedule.
+ *
+ * A view wraps a base schedule plus a small fixed-capacity list of patched
+ * cells, and answers the same queries the constraint evaluators need as if
+ * the patches had been applied. Delta evaluation builds a view on the stack
+ * instead of copying the schedule, so it never allocates.
+ *
+ * Any Schedule converts implicitly to an unpatched view, so evaluators that
+ * take a const ScheduleView& accept schedules unchanged. The base schedule
+ * must outlive the view and must not be modified while the view is in use.
+ */
+class ScheduleView {
+public:
+    static const int MAX_PATCHES = 32;
+
+private:
+    struct Patch {
+        int employee;
+        int day;
+        int shift;
+    };
+
+    const Schedule* base;
+    int num_patches;
+    Patch patches[MAX_PATCHES];
+
+    // Signed change of 'shift' occurrences produced by one patch
+    int patchDelta(const Patch& p, int shift) const {
+        int base_shift = base->getAssignment(p.employee, p.day);
+        return (p.shift == shift) - (base_shift == shift);
+    }
+
+public:
+    ScheduleView(const Schedule& schedule) : base(&schedule), num_patches(0) {}
+
+    /**
+     * Overrides one cell. Patching the same cell twice keeps the latest shift;
+     * out-of-range cells are ignored, matching Schedule::setAssignment.
+     * @throws std::length_error when more than MAX_PATCHES distinct cells are patched
+     */
+    void setAssignment(int employee, int day, int shift) {
+        if (employee < 0 || employee >= base->getNumEmployees() ||
+            day < 0 || day >= base->getHorizonDays()) {
+            return;
+        }
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].employee == employee && patches[i].day == day) {
+                patches[i].shift = shift;
+                return;
+            }
+        }
+        if (num_patches == MAX_PATCHES) {
+            throw std::length_error("ScheduleView: too many patched cells");
+        }
+        patches[num_patches++] = {employee, day, shift};
+    }
+
+    void swapAssignments(int emp1, int day1, int emp2, int day2) {
+        int shift1 = getAssignment(emp1, day1);
+        int shift2 = getAssignment(emp2, day2);
+        setAssignment(emp1, day1, shift2);
+        setAssignment(emp2, day2, shift1);
+    }
+
+    int getAssignment(int employee, int day) const {
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].employee == employee && patches[i].day == day) {
+                return patches[i].shift;
+            }
+        }
+        return base->getAssignment(employee, day);
+    }
+
+    const Schedule& getBase() const { return *base; }
+    int getNumPatches() const { return num_patches; }
+
+    int getNumEmployees() const { return base->getNumEmployees(); }
+    int getHorizonDays() const { return base->getHorizonDays(); }
+    int getNumShiftTypes() const { return base->getNumShiftTypes(); }
+    bool tracksMinutes() const { return base->tracksMinutes(); }
+
+    int getShiftCount(int employee, int shift_type) const {
+        int count = base->getShiftCount(employee, shift_type);
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].employee == employee) {
+                count += patchDelta(patches[i], shift_type);
+            }
+        }
+        return count;
+    }
+
+    int getTotalMinutes(int employee) const {
+        int total = base->getTotalMinutes(employee);
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].employee == employee) {
+                total += base->getShiftMinutes(patches[i].shift) -
+                         base->getShiftMinutes(base->getAssignment(employee, patches[i].day));
+            }
+        }
+        return total;
+    }
+
+    int getTotalMinutes(int employee, const std::vector<int>& shift_durations) const {
+        auto minutes = [&shift_durations](int shift) {
+            return (shift > 0 && shift <= static_cast<int>(shift_durations.size())) ? shift_durations[shift - 1] : 0;
+        };
+        int total = base->getTotalMinutes(employee, shift_durations);
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].employee == employee) {
+                total += minutes(patches[i].shift) - minutes(base->getAssignment(employee, patches[i].day));
+            }
+        }
+        return total;
+    }
+
+    /**
+     * Work bitmask of one employee with the patches applied. Returns the base
+     * schedule's row directly when no patch touches the employee; otherwise the
+     * row is copied into 'scratch' (resized as needed) and patched there, so the
+     * result is only valid until 'scratch' is reused.
+     */
+    const uint64_t* getWorkBits(int employee, std::vector<uint64_t>& scratch) const {
+        const uint64_t* base_bits = base->getWorkBits(employee);
+        int i = 0;
+        while (i < num_patches && patches[i].employee != employee) i++;
+        if (i == num_patches) return base_bits;
+        
+        int words = base->getWorkWords();
+        scratch.assign(base_bits, base_bits + words);
+        for (; i < num_patches; i++) {
+            if (patches[i].employee != employee) continue;
+            if (patches[i].shift != 0) {
+                BitUtils::setBit(scratch.data(), patches[i].day);
+            } else {
+                BitUtils::clearBit(scratch.data(), patches[i].day);
+            }
+        }
+        return scratch.data();
+    }
+    int getWorkWords() const { return base->getWorkWords(); }
+
+    int getCoverage(int day, int shift_type) const {
+        int coverage = base->getCoverage(day, shift_type);
+        for (int i = 0; i < num_patches; i++) {
+            if (patches[i].day == day) {
+                coverage += patchDelta(patches[i], shift_type);
+            }
+        }
+        return coverage;
+    }
+};
+
+#endif // SCHEDULE_VIEW_H
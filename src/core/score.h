@@ -0,0 +1,41 @@
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <cstdint>
+
+/**
+ * Integer score type used by every evaluator and by the search loop.
+ *
+ * Scores are penalties: 0 is best and lower (more negative) is worse. All
+ * constraint penalties are integers, so sums and incremental updates are
+ * exact and can be compared with ==.
+ *
+ * Weighted hard scores are fixed point: a dynamic weight w is stored as
+ * w * WEIGHT_SCALE, so a weighted score is an exact Score in units of
+ * 1/WEIGHT_SCALE. Divide by WEIGHT_SCALE only to print or to feed a
+ * floating-point formula such as the SA acceptance probability.
+ */
+using Score = int64_t;
+
+class ScoreUtils {
+public:
+    static constexpr Score WEIGHT_SCALE = 10000;
+
+    // Offset of the hard score in a lexicographic key; soft scores must stay within +-2^31
+    static constexpr Score HARD_KEY_FACTOR = Score(1) << 32;
+
+    /**
+     * Packs (hard, soft) into one key whose order is lexicographic: a higher
+     * hard score always wins, and soft breaks ties.
+     */
+    static Score lexicographicKey(Score hard, Score soft) {
+        return hard * HARD_KEY_FACTOR + soft;
+    }
+
+    // Weighted (fixed-point) score in natural units
+    static double unscaleWeighted(Score weighted) {
+        return static_cast<double>(weighted) / WEIGHT_SCALE;
+    }
+};
+
+#endif // SCORE_H
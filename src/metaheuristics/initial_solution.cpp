@@ -9,7 +9,7 @@ InitialSolutionGenerator::InitialSolutionGenerator(const Instance& instance)
 }
 
 Schedule InitialSolutionGenerator::generateFeasibleSolution() {
-    Schedule schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes());
+    Schedule schedule(instance);
     
     // Initialize tracking structures
     std::vector<EmployeeState> employee_states(instance.getNumEmployees());
@@ -47,20 +47,12 @@ Schedule InitialSolutionGenerator::generateFeasibleSolution() {
 }
 
 void InitialSolutionGenerator::assignAnnualLeave(Schedule& schedule, std::vector<EmployeeState>& employee_states) {
-    const auto& days_off = instance.getDaysOff();
+    // Frozen cells of the compiled instance: the same mask the move generators honor
+    const CompiledInstance& compiled = instance.getCompiled();
     
-    for (const auto& employee_days_off : days_off) {
-        int employee_index = instance.getStaffIndex(employee_days_off.EmployeeID);
-        
-        if (employee_index == -1) {
-            std::cerr << "Warning: Employee " << employee_days_off.EmployeeID << " not found" << std::endl;
-            continue;
-        }
-        
-        for (const std::string& day_str : employee_days_off.DayIndexes) {
-            int day = std::stoi(day_str);
-            
-            if (instance.isValidDay(day)) {
+    for (int employee_index = 0; employee_index < instance.getNumEmployees(); employee_index++) {
+        for (int day = 0; day < instance.getHorizonDays(); day++) {
+            if (compiled.isDayOff(employee_index, day)) {
                 // Assign day off (shift 0)
                 schedule.setAssignment(employee_index, day, 0);
                 employee_states[employee_index].blocked_days.insert(day);
@@ -394,17 +386,7 @@ bool InitialSolutionGenerator::violatesShiftSequence(int employee, int day, int
     int last_shift = employee_states[employee].last_shift_type;
     if (last_shift <= 0) return false;
     
-    const Shift& last_shift_info = instance.getShift(last_shift-1);
-    const Shift& current_shift_info = instance.getShift(shift-1);
-    
-    // Check if current shift is in the "can't follow" list of the last shift
-    for (const std::string& cant_follow : last_shift_info.cant_follow) {
-        if (cant_follow == current_shift_info.ShiftID) {
-            return true;
-        }
-    }
-    
-    return false;
+    return instance.getCompiled().isForbiddenTransition(last_shift, shift);
 }
 
 bool InitialSolutionGenerator::violatesMaxTotalMinutes(int employee, int shift, 
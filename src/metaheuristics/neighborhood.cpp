@@ -1,10 +1,12 @@
 #include "neighborhood.h"
+#include "../core/schedule_symmetry.h"
 #include "../utils/random.h"
 #include <algorithm>
 #include <vector>
 
 Neighborhood::Neighborhood(int num_employees, int horizon, int num_shift_types, ConstraintEvaluator& evaluator)
-    : num_employees(num_employees), horizon(horizon), num_shift_types(num_shift_types), evaluator(evaluator) {}
+    : num_employees(num_employees), horizon(horizon), num_shift_types(num_shift_types), evaluator(evaluator),
+      candidate_lists(nullptr) {}
 
 Move Neighborhood::getRandomMove(const Schedule& schedule) {
     // Si la solución NO es factible, prioriza los movimientos reparadores
@@ -42,36 +44,102 @@ void Neighborhood::perturb(Schedule& schedule, double rate) {
     }
 }
 
+bool Neighborhood::isFrozen(int employee, int day) const {
+    return evaluator.instance.getCompiled().isDayOff(employee, day);
+}
+
+bool Neighborhood::placesWorkOnFrozenCell(const Schedule& schedule, const Move& move) const {
+    switch (move.type) {
+        case MoveType::Change:
+        case MoveType::FixShiftRotation:
+            return move.shift2 != 0 && isFrozen(move.employee1, move.day1);
+        case MoveType::Swap:
+            return (move.shift2 != 0 && isFrozen(move.employee1, move.day1)) ||
+                   (move.shift1 != 0 && isFrozen(move.employee2, move.day2));
+        case MoveType::BlockSwap:
+            for (int day = move.day1; day <= move.day2; ++day) {
+                if ((schedule.getAssignment(move.employee2, day) != 0 && isFrozen(move.employee1, day)) ||
+                    (schedule.getAssignment(move.employee1, day) != 0 && isFrozen(move.employee2, day))) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
 Move Neighborhood::getRandomChangeMove(const Schedule& schedule) {
     Move move;
     move.type = MoveType::Change;
-    move.employee1 = Random::getInt(0, num_employees - 1);
-    move.day1 = Random::getInt(0, horizon - 1);
-    move.shift1 = schedule.getAssignment(move.employee1, move.day1);
-    move.shift2 = Random::getInt(0, num_shift_types);
+    
+    // Con listas de candidatos: elige (día, turno) y luego un empleado que pueda tomarlo legalmente
+    int target_shift = candidate_lists ? Random::getInt(0, num_shift_types) : 0;
+    if (target_shift != 0) {
+        const CompiledInstance& compiled = evaluator.instance.getCompiled();
+        for (int attempt = 0; attempt < MAX_SAMPLING_ATTEMPTS; ++attempt) {
+            int day = Random::getInt(0, horizon - 1);
+            int employee = candidate_lists->sample(day, target_shift);
+            if (employee < 0 || schedule.getAssignment(employee, day) == target_shift ||
+                schedule.getShiftCount(employee, target_shift) >= compiled.getMaxShifts(employee, target_shift)) {
+                continue;
+            }
+            move.employee1 = employee;
+            move.day1 = day;
+            move.shift1 = schedule.getAssignment(employee, day);
+            move.shift2 = target_shift;
+            return move;
+        }
+    }
+    
+    for (int attempt = 0; attempt < MAX_SAMPLING_ATTEMPTS; ++attempt) {
+        move.employee1 = Random::getInt(0, num_employees - 1);
+        move.day1 = Random::getInt(0, horizon - 1);
+        move.shift1 = schedule.getAssignment(move.employee1, move.day1);
+        if (!isFrozen(move.employee1, move.day1)) {
+            move.shift2 = Random::getInt(0, num_shift_types);
+            return move;
+        }
+        if (move.shift1 != 0) break; // Celda congelada con trabajo: liberarla es una reparación
+    }
+    // Una celda congelada solo puede pasar a día libre
+    move.shift2 = 0;
     return move;
 }
 
 Move Neighborhood::getRandomSwapMove(const Schedule& schedule) {
+    const CompiledInstance& compiled = evaluator.instance.getCompiled();
     Move move;
     move.type = MoveType::Swap;
-    move.employee1 = Random::getInt(0, num_employees - 1);
-    move.day1 = Random::getInt(0, horizon - 1);
-    move.employee2 = Random::getInt(0, num_employees - 1);
-    move.day2 = Random::getInt(0, horizon - 1);
-    move.shift1 = schedule.getAssignment(move.employee1, move.day1);
-    move.shift2 = schedule.getAssignment(move.employee2, move.day2);
-    return move;
+    for (int attempt = 0; attempt < MAX_SAMPLING_ATTEMPTS; ++attempt) {
+        move.employee1 = Random::getInt(0, num_employees - 1);
+        move.day1 = Random::getInt(0, horizon - 1);
+        move.employee2 = Random::getInt(0, num_employees - 1);
+        move.day2 = Random::getInt(0, horizon - 1);
+        move.shift1 = schedule.getAssignment(move.employee1, move.day1);
+        move.shift2 = schedule.getAssignment(move.employee2, move.day2);
+        if (!placesWorkOnFrozenCell(schedule, move) && !ScheduleSymmetry::isNeutralMove(schedule, move, compiled)) {
+            return move;
+        }
+    }
+    return getRandomChangeMove(schedule);
 }
 
 Move Neighborhood::getRandomBlockSwapMove(const Schedule& schedule) {
+    const CompiledInstance& compiled = evaluator.instance.getCompiled();
     Move move;
     move.type = MoveType::BlockSwap;
-    move.employee1 = Random::getInt(0, num_employees - 1);
-    move.employee2 = Random::getInt(0, num_employees - 1);
-    move.day1 = Random::getInt(0, horizon - 2);
-    move.day2 = move.day1 + 1;
-    return move;
+    for (int attempt = 0; attempt < MAX_SAMPLING_ATTEMPTS; ++attempt) {
+        move.employee1 = Random::getInt(0, num_employees - 1);
+        move.employee2 = Random::getInt(0, num_employees - 1);
+        move.day1 = Random::getInt(0, horizon - 2);
+        move.day2 = move.day1 + 1;
+        move.block_size = move.day2 - move.day1 + 1;
+        if (!placesWorkOnFrozenCell(schedule, move) && !ScheduleSymmetry::isNeutralMove(schedule, move, compiled)) {
+            return move;
+        }
+    }
+    return getRandomChangeMove(schedule);
 }
 
 Move Neighborhood::getRandomRuinAndRecreateMove(const Schedule& schedule) {
@@ -82,12 +150,38 @@ Move Neighborhood::getRandomRuinAndRecreateMove(const Schedule& schedule) {
 }
 
 Move Neighborhood::generateFixShiftRotationMove(const Schedule& schedule) {
-    // Placeholder implementation
-    return getRandomChangeMove(schedule);
+    return findFixShiftRotationMove(schedule);
 }
 
 Move Neighborhood::findFixShiftRotationMove(const Schedule& schedule) {
-    // Placeholder implementation
+    const CompiledInstance& compiled = evaluator.instance.getCompiled();
+
+    // Busca la primera transición prohibida en la fila de un empleado al azar: una
+    // sola fila mantiene el coste en O(días) dentro del bucle de SA
+    int emp = Random::getInt(0, num_employees - 1);
+    for (int day = 0; day < horizon - 1; ++day) {
+        int prev = schedule.getAssignment(emp, day);
+        int current = schedule.getAssignment(emp, day + 1);
+        if (!compiled.isForbiddenTransition(prev, current)) continue;
+
+        // Reemplaza el segundo turno por uno compatible con sus dos vecinos (o día libre)
+        int next = (day + 2 < horizon) ? schedule.getAssignment(emp, day + 2) : 0;
+        std::vector<int> candidates;
+        for (int shift = 1; shift <= num_shift_types && !isFrozen(emp, day + 1); ++shift) {
+            if (shift != current && !compiled.isForbiddenTransition(prev, shift) &&
+                !compiled.isForbiddenTransition(shift, next)) {
+                candidates.push_back(shift);
+            }
+        }
+
+        Move move;
+        move.type = MoveType::Change;
+        move.employee1 = emp;
+        move.day1 = day + 1;
+        move.shift1 = current;
+        move.shift2 = candidates.empty() ? 0 : candidates[Random::getInt(0, candidates.size() - 1)];
+        return move;
+    }
     return getRandomChangeMove(schedule);
 }
 
@@ -119,13 +213,7 @@ Move Neighborhood::generateBalanceWorkingTimeMove(const Schedule& schedule) {
     for (int emp = 0; emp < num_employees; ++emp) {
         if (evaluator.getEmployeeHardConstraintViolations(schedule, emp) < 0) {
             const Staff& worker = evaluator.instance.getStaff(emp);
-            int total_minutes = 0;
-            for (int day = 0; day < horizon; ++day) {
-                int shift_id = schedule.getAssignment(emp, day);
-                if (shift_id > 0) {
-                    total_minutes += evaluator.instance.getShift(shift_id - 1).mins;
-                }
-            }
+            int total_minutes = schedule.getTotalMinutes(emp, evaluator.instance.getShiftDurations());
 
             Move move;
             move.type = MoveType::Change;
@@ -134,7 +222,7 @@ Move Neighborhood::generateBalanceWorkingTimeMove(const Schedule& schedule) {
             if (total_minutes < worker.MinTotalMinutes) {
                 // Add a shift on a day off, preferably next to an existing shift
                 for (int day = 1; day < horizon - 1; ++day) {
-                    if (schedule.getAssignment(emp, day) == 0 &&
+                    if (schedule.getAssignment(emp, day) == 0 && !isFrozen(emp, day) &&
                         (schedule.getAssignment(emp, day - 1) > 0 || schedule.getAssignment(emp, day + 1) > 0)) {
                         move.day1 = day;
                         move.shift1 = 0;
@@ -193,7 +281,8 @@ Move Neighborhood::generateFixMinConsecutiveShiftsMove(const Schedule& schedule)
             if (schedule.getAssignment(emp, day) > 0) {
                 consecutive_shifts++;
             } else {
-                if (consecutive_shifts > 0 && consecutive_shifts < evaluator.instance.getStaff(emp).MinConsecutiveShifts) {
+                if (consecutive_shifts > 0 && consecutive_shifts < evaluator.instance.getStaff(emp).MinConsecutiveShifts &&
+                    !isFrozen(emp, day)) {
                     Move move;
                     move.type = MoveType::Change;
                     move.employee1 = emp;
@@ -240,13 +329,7 @@ Move Neighborhood::generateRebalanceWorkloadMove(const Schedule& schedule) {
     // 1. Identificar empleados con carga de trabajo incorrecta
     for (int emp = 0; emp < num_employees; ++emp) {
         const Staff& worker = evaluator.instance.getStaff(emp);
-        int total_minutes = 0;
-        for (int day = 0; day < horizon; ++day) {
-            int shift_id = schedule.getAssignment(emp, day);
-            if (shift_id > 0) {
-                total_minutes += evaluator.instance.getShift(shift_id - 1).mins;
-            }
-        }
+        int total_minutes = schedule.getTotalMinutes(emp, evaluator.instance.getShiftDurations());
 
         if (total_minutes > worker.MaxTotalMinutes) {
             overworked_employees.push_back(emp);
@@ -267,11 +350,11 @@ Move Neighborhood::generateRebalanceWorkloadMove(const Schedule& schedule) {
     // 4. Encuentra un día en el que el empleado sobrecargado trabaje y el infrautilizado no
     std::vector<int> possible_days;
     for (int day = 0; day < horizon; ++day) {
-        if (schedule.getAssignment(emp_over, day) != 0 && schedule.getAssignment(emp_under, day) == 0) {
+        if (schedule.getAssignment(emp_over, day) != 0 && schedule.getAssignment(emp_under, day) == 0 &&
+            !isFrozen(emp_under, day)) {
             // Adicionalmente, verifica si el empleado infrautilizado puede hacer ese turno
-            const Staff& under_worker_info = evaluator.instance.getStaff(emp_under);
             int shift_to_move_id = schedule.getAssignment(emp_over, day);
-            if(under_worker_info.MaxShifts[shift_to_move_id - 1] != "0")
+            if(evaluator.instance.getCompiled().getMaxShifts(emp_under, shift_to_move_id) != 0)
             {
                 possible_days.push_back(day);
             }
@@ -290,6 +373,7 @@ Move Neighborhood::generateRebalanceWorkloadMove(const Schedule& schedule) {
         move.shift1 = shift_to_move; // Turno original del sobrecargado
 
         move.employee2 = emp_under;
+        move.day2 = day_to_swap;
         move.shift2 = 0; // Turno original del infrautilizado (día libre)
 
         return move;
@@ -322,7 +406,7 @@ Move Neighborhood::generateConsolidateWorkMove(const Schedule& schedule) {
                     // Buscar un día libre para este empleado que esté junto a otro bloque de trabajo
                     for (int target_day = 0; target_day < horizon; ++target_day) {
                         // Si el target_day es un día libre...
-                        if (schedule.getAssignment(emp, target_day) == 0) {
+                        if (schedule.getAssignment(emp, target_day) == 0 && !isFrozen(emp, target_day)) {
                             // Y si el día anterior O el siguiente tienen trabajo...
                             bool adjacent_to_work = false;
                             if (target_day > 0 && schedule.getAssignment(emp, target_day - 1) != 0) adjacent_to_work = true;
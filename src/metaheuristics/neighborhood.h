@@ -3,6 +3,7 @@
 
 #include "../core/data_structures.h"
 #include "../core/move.h"
+#include "../core/candidate_lists.h"
 #include "../constraints/constraint_evaluator.h"
 
 class Neighborhood {
@@ -11,6 +12,13 @@ public:
 
     Move getRandomMove(const Schedule& schedule);
     void perturb(Schedule& schedule, double rate);
+    
+    /**
+     * Candidate lists kept in sync with the schedules passed to getRandomMove
+     * (e.g. IncrementalEvaluator::getCandidateLists). Change moves then draw
+     * their employee from the legal candidates; nullptr restores uniform draws.
+     */
+    void setCandidateLists(const CandidateLists* lists) { candidate_lists = lists; }
 
 private:
     Move getRandomChangeMove(const Schedule& schedule);
@@ -27,10 +35,18 @@ private:
     Move generateRebalanceWorkloadMove(const Schedule& schedule);
     Move generateConsolidateWorkMove(const Schedule& schedule);
 
+    // Pre-assigned days off are frozen: no generated move puts work on them
+    bool isFrozen(int employee, int day) const;
+    bool placesWorkOnFrozenCell(const Schedule& schedule, const Move& move) const;
+
     int num_employees;
     int horizon;
     int num_shift_types;
     ConstraintEvaluator& evaluator;
+    const CandidateLists* candidate_lists;
+
+    // Rejection-sampling budget for random moves before falling back to a safe move
+    static const int MAX_SAMPLING_ATTEMPTS = 16;
 };
 
 #endif // NEIGHBORHOOD_H
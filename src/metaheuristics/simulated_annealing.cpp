@@ -2,6 +2,7 @@
 #include "neighborhood.h"
 #include "initial_solution.h"
 #include "../core/data_structures.h"
+#include "../core/schedule_symmetry.h"
 #include "../constraints/incremental_evaluator.h"
 #include "../utils/random.h"
 #include <iostream>
@@ -9,6 +10,34 @@
 #include <cmath>
 #include <algorithm>
 #include <sstream>
+#include <utility>
+
+namespace {
+
+// Restores the evaluator's frozen-cells flag on every exit from solve(), including
+// exceptions, so a failed search never leaves constraint (10) switched off for the caller
+class FrozenCellsFlagGuard {
+public:
+    explicit FrozenCellsFlagGuard(ConstraintEvaluator& evaluator)
+        : evaluator(evaluator), previous(evaluator.areFrozenCellsEnforced()), restored(false) {}
+    ~FrozenCellsFlagGuard() { restore(); }
+    FrozenCellsFlagGuard(const FrozenCellsFlagGuard&) = delete;
+    FrozenCellsFlagGuard& operator=(const FrozenCellsFlagGuard&) = delete;
+
+    void restore() {
+        if (!restored) {
+            evaluator.setFrozenCellsEnforced(previous);
+            restored = true;
+        }
+    }
+
+private:
+    ConstraintEvaluator& evaluator;
+    bool previous;
+    bool restored;
+};
+
+} // namespace
 
 // TabuMemory implementation
 void TabuMemory::addMove(int employee, int day, int shift) {
@@ -51,12 +80,14 @@ std::string TabuMemory::getAssignmentKey(int employee, int day, int shift) const
 }
 
 // DiversificationIntensification implementation
-DiversificationIntensification::DiversificationIntensification(const Instance& instance, ConstraintEvaluator& evaluator)
+DiversificationIntensification::DiversificationIntensification(const Instance& instance, ConstraintEvaluator& evaluator,
+                                                               SchedulePool& pool)
     : instance(instance), evaluator(evaluator), 
-      neighborhood(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes(), evaluator) {}
+      neighborhood(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes(), evaluator),
+      pool(pool) {}
 
 Schedule DiversificationIntensification::diversifyRestart(const Schedule& current_best, double perturbation_rate) {
-    Schedule diversified = current_best;
+    Schedule diversified = pool.acquire(current_best);
     neighborhood.perturb(diversified, perturbation_rate);
     return diversified;
 }
@@ -69,7 +100,7 @@ Schedule DiversificationIntensification::diversifyRandomRestart(const Schedule&
 }
 
 Schedule DiversificationIntensification::diversifyGuidedRestart(const Schedule& current_best) {
-    Schedule guided = current_best;
+    Schedule guided = pool.acquire(current_best);
     
     // Apply guided perturbation focusing on constraint violations
     std::vector<std::pair<int, int>> violations = evaluator.getViolatingAssignments(current_best);
@@ -81,7 +112,8 @@ Schedule DiversificationIntensification::diversifyGuidedRestart(const Schedule&
         // Try to fix this violation by changing to a day off or different shift
         if (Random::getDouble(0.0, 1.0) < 0.7) { // 70% chance to fix
             int current_shift = guided.getAssignment(employee, day);
-            int new_shift = (current_shift == 0) ? Random::getInt(1, instance.getNumShiftTypes()) : 0;
+            bool frozen = instance.getCompiled().isDayOff(employee, day);  // Frozen cells only ever become days off
+            int new_shift = (current_shift == 0 && !frozen) ? Random::getInt(1, instance.getNumShiftTypes()) : 0;
             guided.setAssignment(employee, day, new_shift);
         }
     }
@@ -90,15 +122,16 @@ Schedule DiversificationIntensification::diversifyGuidedRestart(const Schedule&
 }
 
 Schedule DiversificationIntensification::intensifyLocalSearch(const Schedule& schedule, int max_iterations) {
-    Schedule current = schedule;
-    Schedule best = schedule;
-    double best_score = evaluator.evaluateSchedule(schedule);
+    Schedule current = pool.acquire(schedule);
+    Schedule best = pool.acquire(schedule);
+    Schedule temp = pool.acquire();
+    Score best_score = evaluator.evaluateSchedule(schedule);
     
     for (int i = 0; i < max_iterations; ++i) {
         Move move = neighborhood.getRandomMove(current);
         
         // Apply move temporarily to evaluate
-        Schedule temp = current;
+        temp = current;
         if (move.type == MoveType::Change) {
             temp.setAssignment(move.employee1, move.day1, move.shift2);
         } else if (move.type == MoveType::Swap) {
@@ -106,7 +139,7 @@ Schedule DiversificationIntensification::intensifyLocalSearch(const Schedule& sc
             temp.setAssignment(move.employee2, move.day2, move.shift1);
         }
         
-        double new_score = evaluator.evaluateSchedule(temp);
+        Score new_score = evaluator.evaluateSchedule(temp);
         
         // Accept only improving moves (hill climbing)
         if (new_score > best_score) {
@@ -116,6 +149,8 @@ Schedule DiversificationIntensification::intensifyLocalSearch(const Schedule& sc
         }
     }
     
+    pool.release(std::move(current));
+    pool.release(std::move(temp));
     return best;
 }
 
@@ -124,9 +159,10 @@ Schedule DiversificationIntensification::intensifyHillClimbing(const Schedule& s
 }
 
 Schedule DiversificationIntensification::intensifyVariableNeighborhood(const Schedule& schedule, int max_iterations) {
-    Schedule current = schedule;
-    Schedule best = schedule;
-    double best_score = evaluator.evaluateSchedule(schedule);
+    Schedule current = pool.acquire(schedule);
+    Schedule best = pool.acquire(schedule);
+    Schedule temp = pool.acquire();
+    Score best_score = evaluator.evaluateSchedule(schedule);
     
     std::vector<int> neighborhood_types = {0, 1, 2, 3}; // Different move types
     
@@ -146,7 +182,7 @@ Schedule DiversificationIntensification::intensifyVariableNeighborhood(const Sch
             }
             
             // Apply move temporarily
-            Schedule temp = current;
+            temp = current;
             if (move.type == MoveType::Change) {
                 temp.setAssignment(move.employee1, move.day1, move.shift2);
             } else if (move.type == MoveType::Swap) {
@@ -154,7 +190,7 @@ Schedule DiversificationIntensification::intensifyVariableNeighborhood(const Sch
                 temp.setAssignment(move.employee2, move.day2, move.shift1);
             }
             
-            double new_score = evaluator.evaluateSchedule(temp);
+            Score new_score = evaluator.evaluateSchedule(temp);
             
             if (new_score > best_score) {
                 current = temp;
@@ -170,6 +206,8 @@ Schedule DiversificationIntensification::intensifyVariableNeighborhood(const Sch
         }
     }
     
+    pool.release(std::move(current));
+    pool.release(std::move(temp));
     return best;
 }
 
@@ -178,10 +216,11 @@ SimulatedAnnealing::SimulatedAnnealing(const Instance& instance, ConstraintEvalu
                                        int weight_update_freq)
     : instance(instance),
       evaluator(evaluator),
-      incremental_evaluator(evaluator, Schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes())),
+      incremental_evaluator(evaluator, Schedule(instance)),
       neighborhood(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes(), evaluator),
       tabu_memory(50), // Tabu memory size
-      div_int_strategies(instance, evaluator),
+      schedule_pool(instance),
+      div_int_strategies(instance, evaluator, schedule_pool),
       initial_solution_generator(instance),
       initial_temperature(initial_temp),
       cooling_rate(cooling),
@@ -194,7 +233,12 @@ SimulatedAnnealing::SimulatedAnnealing(const Instance& instance, ConstraintEvalu
       diversification_frequency(500),
       elite_size(5),
       weighted_moves_accepted(0),
-      total_moves_evaluated(0) {}
+      total_moves_evaluated(0),
+      neutral_moves_skipped(0),
+      search_buffer_allocations(0) {
+    elite_solutions.reserve(elite_size);
+    neighborhood.setCandidateLists(&incremental_evaluator.getCandidateLists());
+}
 
 Schedule SimulatedAnnealing::solve(SolveMode mode) {
     // Use the 5-step feasible initial solution heuristic instead of random initialization
@@ -205,12 +249,19 @@ Schedule SimulatedAnnealing::solve(SolveMode mode) {
 }
 
 Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode mode) {
-    Schedule current_schedule = initial_schedule;
+    Schedule current_schedule = schedule_pool.acquire(initial_schedule);
+
+    // Every move, restart and repair honors the frozen-cell mask, so a start that keeps
+    // pre-assigned days off empty keeps them empty and that constraint need not be evaluated
+    FrozenCellsFlagGuard frozen_flag(evaluator);
+    evaluator.setFrozenCellsEnforced(false);
+    evaluator.setFrozenCellsEnforced(evaluator.hard_constraints.evaluatePreAssignedDaysOff(current_schedule) == 0);
     incremental_evaluator.reset(current_schedule);
 
     Schedule best_schedule = current_schedule;
-    double best_hard_score = incremental_evaluator.getHardScore();
-    double best_soft_score = incremental_evaluator.getSoftScore();
+    Score best_hard_score = incremental_evaluator.getHardScore();
+    HardScoreVector best_hard_scores = incremental_evaluator.getHardScores();  // For weighted comparisons
+    Score best_soft_score = incremental_evaluator.getSoftScore();
 
     // Initialize elite solutions
     updateEliteSolutions(best_schedule, best_hard_score, best_soft_score);
@@ -220,11 +271,19 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
     int iterations_since_improvement = 0;
     int iterations_since_weight_update = 0;
     restart_count = 0;
+    bool feasible_found = false;
+
+    // Warm the pool up to the loop's peak demand: one buffer per missing elite plus
+    // the intensification working set (best candidate and the three VNS buffers).
+    // Every other schedule in the loop is copied into an existing buffer.
+    const size_t INTENSIFICATION_BUFFERS = 4;
+    schedule_pool.reserve(INTENSIFICATION_BUFFERS + elite_size - elite_solutions.size());
+    size_t allocations_before_search = Schedule::getBufferAllocations() + RunIndex::getBufferAllocations();
 
     for (int i = 0; i < max_iterations; ++i) {
         // Update dynamic weights periodically based on violation patterns
         if (iterations_since_weight_update >= weight_update_frequency) {
-            evaluator.updateDynamicWeights(current_schedule);
+            evaluator.updateDynamicWeights(incremental_evaluator.getHardScores());
             iterations_since_weight_update = 0;
             
             if (i % 1000 == 0) { // Log weight updates occasionally
@@ -233,8 +292,9 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
                 auto violations = evaluator.getViolationCounts();
                 
                 // Show current constraint violations
-                double regular_hard = evaluator.getHardConstraintViolations(current_schedule);
-                double weighted_hard = evaluator.getWeightedHardConstraintViolations(current_schedule);
+                Score regular_hard = incremental_evaluator.getHardScore();
+                double weighted_hard = ScoreUtils::unscaleWeighted(
+                    evaluator.getWeightedHardScore(incremental_evaluator.getHardScores()));
                 
                 std::cout << "  Regular hard score: " << regular_hard << ", Weighted: " << weighted_hard << std::endl;
                 
@@ -266,7 +326,10 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
             std::cout << "--- DIVERSIFICATION: Applying guided restart ---" << std::endl;
             
             Schedule diversification_base = selectDiversificationBase();
-            current_schedule = div_int_strategies.diversifyGuidedRestart(diversification_base);
+            Schedule guided = div_int_strategies.diversifyGuidedRestart(diversification_base);
+            std::swap(current_schedule, guided);
+            schedule_pool.release(std::move(guided));
+            schedule_pool.release(std::move(diversification_base));
             
             incremental_evaluator.reset(current_schedule);
             temperature = initial_temperature * 0.8; // Slightly lower temperature after restart
@@ -283,18 +346,19 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
             std::cout << "--- INTENSIFICATION: Applying local search on elite solutions ---" << std::endl;
             
             // Try intensification on multiple elite solutions, not just the best
-            Schedule best_intensified = best_schedule;
-            double best_intensified_score = evaluator.evaluateSchedule(best_schedule);
+            Schedule best_intensified = schedule_pool.acquire(best_schedule);
+            Score best_intensified_score = evaluator.evaluateSchedule(best_schedule);
             
             // Intensify around each elite solution
             for (const auto& elite : elite_solutions) {
                 Schedule intensified = div_int_strategies.intensifyVariableNeighborhood(elite, 30);
-                double intensified_score = evaluator.evaluateSchedule(intensified);
+                Score intensified_score = evaluator.evaluateSchedule(intensified);
                 
                 if (intensified_score > best_intensified_score) {
                     best_intensified = intensified;
                     best_intensified_score = intensified_score;
                 }
+                schedule_pool.release(std::move(intensified));
             }
             
             if (best_intensified_score > evaluator.evaluateSchedule(best_schedule)) {
@@ -302,7 +366,8 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
                 current_schedule = best_intensified;
                 incremental_evaluator.reset(current_schedule);
                 
-                best_hard_score = evaluator.getHardConstraintViolations(best_schedule);
+                best_hard_score = incremental_evaluator.getHardScore();
+                best_hard_scores = incremental_evaluator.getHardScores();
                 best_soft_score = evaluator.getSoftConstraintViolations(best_schedule);
                 updateEliteSolutions(best_schedule, best_hard_score, best_soft_score);
                 
@@ -311,37 +376,35 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
                 
                 std::cout << "  Elite-based intensification improved solution!" << std::endl;
             }
+            schedule_pool.release(std::move(best_intensified));
         }
 
         Move move = neighborhood.getRandomMove(current_schedule);
         
-        // Check tabu status (with aspiration criteria)
+        // Moves that provably change no score (no-ops or swaps of interchangeable
+        // employees) are neither evaluated nor applied
+        bool neutral = ScheduleSymmetry::isNeutralMove(current_schedule, move, instance.getCompiled());
+        if (neutral) {
+            neutral_moves_skipped++;
+        }
+        
+        // Check tabu status (with aspiration criteria); equivalent employees share tabu entries
         bool is_tabu = false;
-        if (move.type == MoveType::Change) {
-            is_tabu = tabu_memory.isTabu(move.employee1, move.day1, move.shift2);
+        if (!neutral && move.type == MoveType::Change) {
+            is_tabu = tabu_memory.isTabu(instance.getCompiled().getEmployeeClass(move.employee1), move.day1, move.shift2);
         }
         
-        double delta_hard = incremental_evaluator.getHardScoreDelta(move);
-        double delta_soft = incremental_evaluator.getSoftScoreDelta(move);
-        double new_hard_score = incremental_evaluator.getHardScore() + delta_hard;
-        double new_soft_score = incremental_evaluator.getSoftScore() + delta_soft;
+        HardScoreVector delta_hard_scores = neutral ? HardScoreVector() : incremental_evaluator.getHardScoreDeltas(move);
+        Score delta_hard = delta_hard_scores.total();
+        Score delta_soft = neutral ? 0 : incremental_evaluator.getSoftScoreDelta(move);
+        Score new_hard_score = incremental_evaluator.getHardScore() + delta_hard;
+        Score new_soft_score = incremental_evaluator.getSoftScore() + delta_soft;
         
-        // For infeasible solutions, use weighted evaluation to guide search
-        double delta_to_use = delta_hard;
-        if (incremental_evaluator.getHardScore() < 0) {
-            // Use weighted evaluation for better constraint handling in infeasible region
-            double current_weighted_hard = evaluator.getWeightedHardConstraintViolations(current_schedule);
-            
-            // Create temporary schedule to evaluate weighted score after move
-            Schedule temp_schedule = current_schedule;
-            if (move.type == MoveType::Change) {
-                temp_schedule.setAssignment(move.employee1, move.day1, move.shift2);
-            } else if (move.type == MoveType::Swap) {
-                temp_schedule.setAssignment(move.employee1, move.day1, move.shift2);
-                temp_schedule.setAssignment(move.employee2, move.day2, move.shift1);
-            }
-            double new_weighted_hard = evaluator.getWeightedHardConstraintViolations(temp_schedule);
-            delta_to_use = new_weighted_hard - current_weighted_hard;
+        // For infeasible solutions, use weighted evaluation to guide search: the weighted
+        // delta is the per-constraint delta dotted with the dynamic weights (fixed point)
+        Score weighted_delta = delta_hard * ScoreUtils::WEIGHT_SCALE;
+        if (!neutral && incremental_evaluator.getHardScore() < 0) {
+            weighted_delta = evaluator.getWeightedHardScore(delta_hard_scores);
         }
 
         bool accept_move = false;
@@ -353,42 +416,34 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
         if (is_tabu) {
             if (incremental_evaluator.getHardScore() < 0) {
                 // In infeasible region, use weighted evaluation for aspiration
-                double current_weighted = evaluator.getWeightedHardConstraintViolations(current_schedule);
-                Schedule temp_schedule = current_schedule;
-                if (move.type == MoveType::Change) {
-                    temp_schedule.setAssignment(move.employee1, move.day1, move.shift2);
-                } else if (move.type == MoveType::Swap) {
-                    temp_schedule.setAssignment(move.employee1, move.day1, move.shift2);
-                    temp_schedule.setAssignment(move.employee2, move.day2, move.shift1);
-                }
-                double new_weighted = evaluator.getWeightedHardConstraintViolations(temp_schedule);
-                double best_weighted = evaluator.getWeightedHardConstraintViolations(best_schedule);
+                Score new_weighted = evaluator.getWeightedHardScore(incremental_evaluator.getHardScores()) + weighted_delta;
+                Score best_weighted = evaluator.getWeightedHardScore(best_hard_scores);
                 aspiration = (new_weighted > best_weighted);
             } else {
                 // In feasible region, use regular scores
-                aspiration = (new_hard_score > best_hard_score || 
-                             (new_hard_score == best_hard_score && new_soft_score > best_soft_score));
+                aspiration = ScoreUtils::lexicographicKey(new_hard_score, new_soft_score) >
+                             ScoreUtils::lexicographicKey(best_hard_score, best_soft_score);
             }
         }
 
-        total_moves_evaluated++;
+        total_moves_evaluated += neutral ? 0 : 1;
         
-        if (!is_tabu || aspiration) {
+        if (!neutral && (!is_tabu || aspiration)) {
             if (incremental_evaluator.getHardScore() < 0) {
                 // Use weighted delta for better constraint handling in infeasible region
-                double acceptance_prob = acceptance(delta_to_use, temperature);
+                double acceptance_prob = acceptance(ScoreUtils::unscaleWeighted(weighted_delta), temperature);
                 double regular_acceptance_prob = acceptance(delta_hard, temperature);
                 
                 if (acceptance_prob > random_prob) {
                     accept_move = true;
                     
                     // Track when weighted evaluation makes a difference
-                    if (std::abs(delta_to_use - delta_hard) > 0.1) {
+                    if (weighted_delta != delta_hard * ScoreUtils::WEIGHT_SCALE) {
                         weighted_moves_accepted++;
                         
                         // Debug: Show when weighted evaluation makes a difference
                         if (i % 10000 == 0) {
-                            std::cout << "  Weighted delta (" << delta_to_use 
+                            std::cout << "  Weighted delta (" << ScoreUtils::unscaleWeighted(weighted_delta)
                                       << ") vs Regular delta (" << delta_hard 
                                       << ") - Weighted prob: " << acceptance_prob 
                                       << ", Regular prob: " << regular_acceptance_prob << std::endl;
@@ -412,7 +467,7 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
             
             // Add move to tabu memory
             if (move.type == MoveType::Change) {
-                tabu_memory.addMove(move.employee1, move.day1, move.shift1); // Add the old assignment as tabu
+                tabu_memory.addMove(instance.getCompiled().getEmployeeClass(move.employee1), move.day1, move.shift1); // Add the old assignment as tabu
             }
         }
 
@@ -421,19 +476,20 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
         
         if (best_hard_score < 0 && incremental_evaluator.getHardScore() < 0) {
             // Both current and best are infeasible - compare using weighted scores
-            double current_weighted = evaluator.getWeightedHardConstraintViolations(current_schedule);
-            double best_weighted = evaluator.getWeightedHardConstraintViolations(best_schedule);
+            Score current_weighted = evaluator.getWeightedHardScore(incremental_evaluator.getHardScores());
+            Score best_weighted = evaluator.getWeightedHardScore(best_hard_scores);
             is_new_best = (current_weighted > best_weighted);
         } else {
             // At least one is feasible - use regular comparison
-            is_new_best = (incremental_evaluator.getHardScore() > best_hard_score ||
-                          (incremental_evaluator.getHardScore() == best_hard_score && 
-                           incremental_evaluator.getSoftScore() > best_soft_score));
+            is_new_best = ScoreUtils::lexicographicKey(incremental_evaluator.getHardScore(),
+                                                       incremental_evaluator.getSoftScore()) >
+                          ScoreUtils::lexicographicKey(best_hard_score, best_soft_score);
         }
         
         if (is_new_best) {
             best_schedule = current_schedule;
             best_hard_score = incremental_evaluator.getHardScore();
+            best_hard_scores = incremental_evaluator.getHardScores();
             best_soft_score = incremental_evaluator.getSoftScore();
             updateEliteSolutions(best_schedule, best_hard_score, best_soft_score);
             
@@ -451,11 +507,17 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
             // Try path relinking with elite solutions first
             if (elite_solutions.size() >= 2 && Random::getDouble(0.0, 1.0) < 0.5) {
                 std::cout << "--- PATH RELINKING: Combining elite solutions ---" << std::endl;
-                current_schedule = pathRelinkingWithElites();
+                Schedule relinked = pathRelinkingWithElites();
+                std::swap(current_schedule, relinked);
+                schedule_pool.release(std::move(relinked));
             } else {
                 std::cout << "--- TRADITIONAL RESTART: Reheating and perturbing ---" << std::endl;
                 current_schedule = best_schedule;
+                // The candidate lists describe the incremental evaluator's schedule, not this
+                // copy being perturbed: draw uniformly until the reset below resyncs them
+                neighborhood.setCandidateLists(nullptr);
                 neighborhood.perturb(current_schedule, 0.15);
+                neighborhood.setCandidateLists(&incremental_evaluator.getCandidateLists());
             }
             
             incremental_evaluator.reset(current_schedule);
@@ -470,8 +532,8 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
         
         if (i % 100 == 0) {
             double current_weighted = (incremental_evaluator.getHardScore() < 0) ? 
-                evaluator.getWeightedHardConstraintViolations(current_schedule) : 
-                incremental_evaluator.getHardScore();
+                ScoreUtils::unscaleWeighted(evaluator.getWeightedHardScore(incremental_evaluator.getHardScores())) : 
+                static_cast<double>(incremental_evaluator.getHardScore());
                 
             std::cout << "Iteration " << i << ": "
                       << "Best Hard Score = " << best_hard_score
@@ -486,26 +548,37 @@ Schedule SimulatedAnnealing::solve(const Schedule& initial_schedule, SolveMode m
 
         if (mode == SolveMode::Feasibility && best_hard_score == 0) {
             std::cout << "Feasible solution found!" << std::endl;
-            return best_schedule;
+            feasible_found = true;
+            break;
         }
     }
 
+    search_buffer_allocations = Schedule::getBufferAllocations() + RunIndex::getBufferAllocations() -
+                                allocations_before_search;
+    frozen_flag.restore();
+    schedule_pool.release(std::move(current_schedule));
+    if (feasible_found) {
+        return best_schedule;
+    }
+
     // Show dynamic weights effectiveness summary
     std::cout << "\n=== Dynamic Weights Effectiveness Summary ===" << std::endl;
     std::cout << "Total moves evaluated: " << total_moves_evaluated << std::endl;
     std::cout << "Moves where weighted evaluation made a difference: " << weighted_moves_accepted << std::endl;
+    std::cout << "Neutral moves skipped (employee symmetry): " << neutral_moves_skipped << std::endl;
     if (total_moves_evaluated > 0) {
         double effectiveness_rate = (double)weighted_moves_accepted / total_moves_evaluated * 100.0;
         std::cout << "Weighted evaluation effectiveness: " << effectiveness_rate << "%" << std::endl;
     }
+    std::cout << "Schedule and run index buffer allocations in search loop: " << search_buffer_allocations << std::endl;
     
     // Show final weight status
     auto final_weights = evaluator.getDynamicWeights();
     auto final_violations = evaluator.getViolationCounts();
     std::cout << "\nElite solutions quality:" << std::endl;
     for (size_t i = 0; i < elite_solutions.size(); ++i) {
-        double hard_score = evaluator.getHardConstraintViolations(elite_solutions[i]);
-        double soft_score = evaluator.getSoftConstraintViolations(elite_solutions[i]);
+        Score hard_score = evaluator.getHardConstraintViolations(elite_solutions[i]);
+        Score soft_score = evaluator.getSoftConstraintViolations(elite_solutions[i]);
         std::cout << "  Elite " << (i+1) << ": Hard=" << hard_score << ", Soft=" << soft_score;
         if (hard_score == 0) std::cout << " (FEASIBLE!)";
         std::cout << std::endl;
@@ -560,7 +633,14 @@ bool SimulatedAnnealing::shouldIntensify(int iterations_since_improvement) {
     return iterations_since_improvement > 0 && iterations_since_improvement % intensification_frequency == 0;
 }
 
-void SimulatedAnnealing::updateEliteSolutions(const Schedule& schedule, double hard_score, double soft_score) {
+void SimulatedAnnealing::updateEliteSolutions(const Schedule& schedule, Score hard_score, Score soft_score) {
+    // Reject duplicates, including schedules that only permute rows of equivalent employees
+    for (const auto& elite : elite_solutions) {
+        if (ScheduleSymmetry::equivalent(elite, schedule, instance.getCompiled())) {
+            return;
+        }
+    }
+    
     // Add to elite solutions if it's better than the worst elite or if we have space
     bool should_add = false;
     
@@ -568,29 +648,27 @@ void SimulatedAnnealing::updateEliteSolutions(const Schedule& schedule, double h
         should_add = true;
     } else {
         // Find the worst elite solution
-        double worst_hard = evaluator.getHardConstraintViolations(elite_solutions[0]);
-        double worst_soft = evaluator.getSoftConstraintViolations(elite_solutions[0]);
+        Score worst_key = ScoreUtils::lexicographicKey(evaluator.getHardConstraintViolations(elite_solutions[0]),
+                                                       evaluator.getSoftConstraintViolations(elite_solutions[0]));
         int worst_index = 0;
         
         for (int i = 1; i < elite_solutions.size(); ++i) {
-            double curr_hard = evaluator.getHardConstraintViolations(elite_solutions[i]);
-            double curr_soft = evaluator.getSoftConstraintViolations(elite_solutions[i]);
-            
-            if (curr_hard < worst_hard || (curr_hard == worst_hard && curr_soft < worst_soft)) {
-                worst_hard = curr_hard;
-                worst_soft = curr_soft;
+            Score curr_key = ScoreUtils::lexicographicKey(evaluator.getHardConstraintViolations(elite_solutions[i]),
+                                                          evaluator.getSoftConstraintViolations(elite_solutions[i]));
+            if (curr_key < worst_key) {
+                worst_key = curr_key;
                 worst_index = i;
             }
         }
         
         // Replace if current solution is better than worst elite
-        if (hard_score > worst_hard || (hard_score == worst_hard && soft_score > worst_soft)) {
+        if (ScoreUtils::lexicographicKey(hard_score, soft_score) > worst_key) {
             elite_solutions[worst_index] = schedule;
         }
     }
     
     if (should_add) {
-        elite_solutions.push_back(schedule);
+        elite_solutions.push_back(schedule_pool.acquire(schedule));
     }
 }
 
@@ -601,34 +679,34 @@ Schedule SimulatedAnnealing::selectDiversificationBase() {
     }
     
     // Smart selection: prefer feasible solutions, or least infeasible ones
-    Schedule best_base = elite_solutions[0];
-    double best_hard_score = evaluator.getHardConstraintViolations(best_base);
+    const Schedule* best_base = &elite_solutions[0];
+    Score best_hard_score = evaluator.getHardConstraintViolations(*best_base);
     
     for (const auto& elite : elite_solutions) {
-        double elite_hard_score = evaluator.getHardConstraintViolations(elite);
+        Score elite_hard_score = evaluator.getHardConstraintViolations(elite);
         
         // Prefer feasible solutions, or less infeasible ones
         if (elite_hard_score > best_hard_score) {
-            best_base = elite;
+            best_base = &elite;
             best_hard_score = elite_hard_score;
         }
     }
     
     std::cout << "  Selected diversification base with hard score: " << best_hard_score << std::endl;
-    return best_base;
+    return schedule_pool.acquire(*best_base);
 }
 
 Schedule SimulatedAnnealing::pathRelinkingWithElites() {
     if (elite_solutions.size() < 2) {
         return elite_solutions.empty() ? 
-            Schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes()) :
-            elite_solutions[0];
+            schedule_pool.acquire() :
+            schedule_pool.acquire(elite_solutions[0]);
     }
     
     // Simple path relinking: combine assignments from two different elite solutions
-    Schedule source = elite_solutions[0];
-    Schedule target = elite_solutions[elite_solutions.size() - 1];
-    Schedule combined = source;
+    const Schedule& source = elite_solutions[0];
+    const Schedule& target = elite_solutions[elite_solutions.size() - 1];
+    Schedule combined = schedule_pool.acquire(source);
     
     // Copy some assignments from target to source
     for (int emp = 0; emp < instance.getNumEmployees(); ++emp) {
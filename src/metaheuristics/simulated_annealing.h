@@ -3,6 +3,7 @@
 
 #include "../core/instance.h"
 #include "../core/data_structures.h"
+#include "../core/schedule_pool.h"
 #include "../constraints/incremental_evaluator.h"
 #include "../core/move.h"
 #include "neighborhood.h"
@@ -13,7 +14,8 @@
 
 enum class SolveMode { Feasibility, Optimization };
 
-// Tabu-like memory structure to avoid cycling
+// Tabu-like memory structure to avoid cycling.
+// Callers key entries by employee class, so equivalent employees share them.
 struct TabuMemory {
     std::deque<std::pair<int, int>> recent_moves; // (employee, day) pairs
     std::unordered_set<std::string> tabu_assignments; // String representation of assignments
@@ -27,10 +29,11 @@ struct TabuMemory {
     std::string getAssignmentKey(int employee, int day, int shift) const;
 };
 
-// Diversification and intensification strategies
+// Diversification and intensification strategies.
+// Returned schedules come from the shared pool; callers should release them back.
 class DiversificationIntensification {
 public:
-    DiversificationIntensification(const Instance& instance, ConstraintEvaluator& evaluator);
+    DiversificationIntensification(const Instance& instance, ConstraintEvaluator& evaluator, SchedulePool& pool);
     
     // Diversification strategies
     Schedule diversifyRestart(const Schedule& current_best, double perturbation_rate);
@@ -46,6 +49,7 @@ private:
     const Instance& instance;
     ConstraintEvaluator& evaluator;
     Neighborhood neighborhood;
+    SchedulePool& pool;
 };
 
 class SimulatedAnnealing {
@@ -59,6 +63,13 @@ public:
     
     // Generate feasible initial solution using the 5-step heuristic
     Schedule generateFeasibleInitialSolution();
+    
+    // Schedule and RunIndex buffer allocations made inside the main loop of the last solve
+    // (0 in steady state). Tabu keys and other small scratch containers are not counted.
+    size_t getSearchBufferAllocations() const { return search_buffer_allocations; }
+    
+    // Elite pool of the last solve, e.g. to checkpoint with ScheduleArchive for warm starts
+    const std::vector<Schedule>& getEliteSolutions() const { return elite_solutions; }
 
 private:
     const Instance& instance;
@@ -66,6 +77,7 @@ private:
     IncrementalEvaluator incremental_evaluator;
     Neighborhood neighborhood;
     TabuMemory tabu_memory;
+    SchedulePool schedule_pool;  // Declared before the strategies that borrow it
     DiversificationIntensification div_int_strategies;
     InitialSolutionGenerator initial_solution_generator;
 
@@ -87,13 +99,15 @@ private:
     // Statistics for dynamic weights effectiveness
     int weighted_moves_accepted;
     int total_moves_evaluated;
+    int neutral_moves_skipped;  // Symmetric or no-op moves skipped without evaluation
+    size_t search_buffer_allocations;
 
     double acceptance(double delta, double temperature);
     bool shouldDiversify(int iterations_since_improvement);
     bool shouldIntensify(int iterations_since_improvement);
-    void updateEliteSolutions(const Schedule& schedule, double hard_score, double soft_score);
-    Schedule selectDiversificationBase();
-    Schedule pathRelinkingWithElites();
+    void updateEliteSolutions(const Schedule& schedule, Score hard_score, Score soft_score);
+    Schedule selectDiversificationBase();  // Pooled
+    Schedule pathRelinkingWithElites();    // Pooled
 };
 
 #endif // SIMULATED_ANNEALING_H
@@ -0,0 +1,101 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal sequential encoder for binary files: fixed-size values in native
+ * byte order, strings and vectors prefixed with a uint32 length.
+ */
+class BinaryWriter {
+private:
+    std::vector<char> buffer;
+
+public:
+    void writeBytes(const void* data, size_t length) {
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + length);
+    }
+
+    void writeInt(int value) { writeBytes(&value, sizeof(value)); }
+    void writeUInt32(uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void writeUInt64(uint64_t value) { writeBytes(&value, sizeof(value)); }
+
+    void writeString(const std::string& value) {
+        writeUInt32(static_cast<uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    // Vectors of trivially copyable values, written as one block
+    template <typename T>
+    void writeVector(const std::vector<T>& values) {
+        writeUInt32(static_cast<uint32_t>(values.size()));
+        writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    const std::vector<char>& data() const { return buffer; }
+};
+
+/**
+ * Bounds-checked decoder over a read-only buffer (typically a MappedFile).
+ * A read past the end fails and leaves the reader failed; callers check
+ * ok() once after decoding instead of after every value.
+ */
+class BinaryReader {
+private:
+    const char* begin;
+    size_t length;
+    size_t position;
+    bool failed;
+
+public:
+    BinaryReader(const char* data, size_t size) : begin(data), length(size), position(0), failed(false) {}
+
+    bool readBytes(void* out, size_t count) {
+        if (failed || count > length - position) {
+            failed = true;
+            return false;
+        }
+        if (count > 0) {
+            std::memcpy(out, begin + position, count);
+        }
+        position += count;
+        return true;
+    }
+
+    int readInt() { int value = 0; readBytes(&value, sizeof(value)); return value; }
+    uint32_t readUInt32() { uint32_t value = 0; readBytes(&value, sizeof(value)); return value; }
+    uint64_t readUInt64() { uint64_t value = 0; readBytes(&value, sizeof(value)); return value; }
+
+    std::string readString() {
+        uint32_t size = readUInt32();
+        if (failed || size > length - position) {
+            failed = true;
+            return std::string();
+        }
+        std::string value(begin + position, size);
+        position += size;
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> readVector() {
+        uint32_t size = readUInt32();
+        if (failed || size > (length - position) / sizeof(T)) {
+            failed = true;
+            return std::vector<T>();
+        }
+        std::vector<T> values(size);
+        readBytes(values.data(), size * sizeof(T));
+        return values;
+    }
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return position == length; }
+};
+
+#endif // BINARY_IO_H
@@ -0,0 +1,116 @@
+#ifndef BIT_UTILS_H
+#define BIT_UTILS_H
+
+#include <cstdint>
+
+/**
+ * Word-level helpers for multi-word bitsets stored as uint64_t arrays,
+ * bit i living in words[i / 64] at position i % 64.
+ */
+class BitUtils {
+public:
+    static const int WORD_BITS = 64;
+
+    static int wordsFor(int bits) { return (bits + WORD_BITS - 1) / WORD_BITS; }
+
+    static int popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int count = 0;
+        for (; word; word &= word - 1) count++;
+        return count;
+#endif
+    }
+
+    // Index of the lowest set bit, 64 for an empty word
+    static int countTrailingZeros(uint64_t word) {
+        if (word == 0) return WORD_BITS;
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int count = 0;
+        for (; (word & 1) == 0; word >>= 1) count++;
+        return count;
+#endif
+    }
+
+    // Index of the highest set bit, -1 for an empty word
+    static int highestBit(uint64_t word) {
+        if (word == 0) return -1;
+#if defined(__GNUC__) || defined(__clang__)
+        return WORD_BITS - 1 - __builtin_clzll(word);
+#else
+        int bit = -1;
+        for (; word; word >>= 1) bit++;
+        return bit;
+#endif
+    }
+
+    static bool testBit(const uint64_t* words, int bit) {
+        return (words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+    }
+
+    static void setBit(uint64_t* words, int bit) {
+        words[bit / WORD_BITS] |= uint64_t(1) << (bit % WORD_BITS);
+    }
+
+    static void clearBit(uint64_t* words, int bit) {
+        words[bit / WORD_BITS] &= ~(uint64_t(1) << (bit % WORD_BITS));
+    }
+
+    // First set bit at or after 'from', or 'limit' if there is none before it
+    static int nextSetBit(const uint64_t* words, int from, int limit) {
+        return nextBit(words, from, limit, 0);
+    }
+
+    // First clear bit at or after 'from', or 'limit' if there is none before it
+    static int nextClearBit(const uint64_t* words, int from, int limit) {
+        return nextBit(words, from, limit, ~uint64_t(0));
+    }
+
+    // Last set bit at or before 'from', or -1 if there is none
+    static int prevSetBit(const uint64_t* words, int from) {
+        return prevBit(words, from, 0);
+    }
+
+    // Last clear bit at or before 'from', or -1 if there is none
+    static int prevClearBit(const uint64_t* words, int from) {
+        return prevBit(words, from, ~uint64_t(0));
+    }
+
+    static int countSetBits(const uint64_t* words, int num_words) {
+        int count = 0;
+        for (int i = 0; i < num_words; i++) count += popcount(words[i]);
+        return count;
+    }
+
+private:
+    // Scans for a set bit in (word ^ invert), whole words at a time
+    static int nextBit(const uint64_t* words, int from, int limit, uint64_t invert) {
+        if (from >= limit) return limit;
+        int index = from / WORD_BITS;
+        uint64_t word = (words[index] ^ invert) & (~uint64_t(0) << (from % WORD_BITS));
+        int last_index = (limit - 1) / WORD_BITS;
+        while (word == 0) {
+            if (++index > last_index) return limit;
+            word = words[index] ^ invert;
+        }
+        int bit = index * WORD_BITS + countTrailingZeros(word);
+        return bit < limit ? bit : limit;
+    }
+
+    // Scans backwards for a set bit in (word ^ invert), whole words at a time
+    static int prevBit(const uint64_t* words, int from, uint64_t invert) {
+        if (from < 0) return -1;
+        int index = from / WORD_BITS;
+        uint64_t word = (words[index] ^ invert) & (~uint64_t(0) >> (WORD_BITS - 1 - from % WORD_BITS));
+        while (word == 0) {
+            if (--index < 0) return -1;
+            word = words[index] ^ invert;
+        }
+        return index * WORD_BITS + highestBit(word);
+    }
+};
+
+#endif // BIT_UTILS_H
@@ -0,0 +1,36 @@
+#ifndef HASH_UTILS_H
+#define HASH_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * 64-bit FNV-1a hashing, used to fingerprint instances and their source files.
+ * Values are hashed in native byte order.
+ */
+class HashUtils {
+public:
+    static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    static void hashBytes(uint64_t& hash, const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; i++) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    static void hashInt(uint64_t& hash, int value) {
+        hashBytes(hash, &value, sizeof(value));
+    }
+
+    // Length-prefixed, so ("ab", "c") and ("a", "bc") differ
+    static void hashString(uint64_t& hash, const std::string& value) {
+        hashInt(hash, static_cast<int>(value.size()));
+        hashBytes(hash, value.data(), value.size());
+    }
+};
+
+#endif // HASH_UTILS_H
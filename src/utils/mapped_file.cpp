@@ -0,0 +1,107 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : mapped_data(nullptr), mapped_size(0), is_open(false),
+      file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr) {}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    is_open = true;
+    if (mapped_size == 0) return true;  // Windows cannot map empty files
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mapping_handle = mapping;
+    mapped_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (mapped_data == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) UnmapViewOfFile(mapped_data);
+    if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+    if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+    mapped_data = nullptr;
+    mapped_size = 0;
+    is_open = false;
+    file_handle = INVALID_HANDLE_VALUE;
+    mapping_handle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : mapped_data(nullptr), mapped_size(0), is_open(false) {}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_t file_size = static_cast<size_t>(file_stat.st_size);
+    if (file_size > 0) {
+        void* address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        mapped_data = static_cast<const char*>(address);
+    }
+    ::close(fd);  // The mapping stays valid without the descriptor
+
+    mapped_size = file_size;
+    is_open = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) {
+        munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+    is_open = false;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
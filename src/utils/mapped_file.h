@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file (mmap on POSIX, a file mapping
+ * view on Windows). The contents are paged in on demand and stay valid until
+ * the object is closed or destroyed. An empty file opens successfully with
+ * size() == 0 and a null data() pointer.
+ */
+class MappedFile {
+private:
+    const char* mapped_data;
+    size_t mapped_size;
+    bool is_open;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps 'path', closing any previous mapping. Returns false if the file cannot be mapped.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return is_open; }
+    const char* data() const { return mapped_data; }
+    size_t size() const { return mapped_size; }
+};
+
+#endif // MAPPED_FILE_H
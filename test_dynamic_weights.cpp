@@ -68,7 +68,7 @@ void testDynamicWeights() {
     // Test weighted evaluation
     std::cout << "\nTesting weighted evaluation..." << std::endl;
     double regular_hard_score = evaluator.getHardConstraintViolations(schedule);
-    double weighted_hard_score = evaluator.getWeightedHardConstraintViolations(schedule);
+    double weighted_hard_score = ScoreUtils::unscaleWeighted(evaluator.getWeightedHardConstraintViolations(schedule));
     
     std::cout << "Regular hard constraint score: " << regular_hard_score << std::endl;
     std::cout << "Weighted hard constraint score: " << weighted_hard_score << std::endl;
@@ -147,7 +147,7 @@ void testDynamicWeightUpdates() {
     
     // Test weighted evaluation
     double regular_score = evaluator.getHardConstraintViolations(schedule);
-    double weighted_score = evaluator.getWeightedHardConstraintViolations(schedule);
+    double weighted_score = ScoreUtils::unscaleWeighted(evaluator.getWeightedHardConstraintViolations(schedule));
     
     std::cout << "Final evaluation comparison:" << std::endl;
     std::cout << "  Regular hard score: " << regular_score << std::endl;
@@ -2,8 +2,11 @@
 #include "../src/constraints/hard_constraints.h"
 #include "../src/core/instance.h"
 #include "../src/core/data_structures.h"
+#include "../src/core/run_index.h"
 #include <iostream>
 #include <cassert>
+#include <random>
+#include <stdexcept>
 
 TestHardConstraints::TestHardConstraints() : tests_passed(0), tests_failed(0) {}
 
@@ -194,6 +197,107 @@ bool TestHardConstraints::testShiftRotation() {
     return true;
 }
 
+bool TestHardConstraints::testRunConstraintsDelta() {
+    Instance instance;
+    if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+        logTest("Run Constraints Delta", false, "Failed to load test instance");
+        return false;
+    }
+    
+    HardConstraints constraints(instance);
+    Schedule schedule(instance);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> shift_dis(0, instance.getNumShiftTypes());
+    for (int emp = 0; emp < schedule.getNumEmployees(); emp++) {
+        for (int day = 0; day < schedule.getHorizonDays(); day++) {
+            schedule.setAssignment(emp, day, shift_dis(gen));
+        }
+    }
+    RunIndex runs(schedule);
+    
+    auto run_score = [&](const Schedule& s, int emp) {
+        return constraints.evaluateMaxConsecutiveShifts(s, emp) +
+               constraints.evaluateMinConsecutiveShifts(s, emp) +
+               constraints.evaluateMinConsecutiveDaysOff(s, emp);
+    };
+    
+    // Flip cells one by one: the local delta must match a full rescan, and the
+    // index must keep matching the schedule's runs
+    bool test1 = true;
+    std::uniform_int_distribution<> emp_dis(0, schedule.getNumEmployees() - 1);
+    std::uniform_int_distribution<> day_dis(0, schedule.getHorizonDays() - 1);
+    for (int step = 0; step < 200 && test1; step++) {
+        int emp = emp_dis(gen);
+        int day = day_dis(gen);
+        bool working = schedule.getAssignment(emp, day) == 0;
+        
+        int local_delta = constraints.calculateRunConstraintsDelta(runs, emp, day, working);
+        int before = run_score(schedule, emp);
+        schedule.setAssignment(emp, day, working ? 1 : 0);
+        runs.update(emp, day, working);
+        test1 = (local_delta == run_score(schedule, emp) - before);
+        
+        for (const auto& run : runs.getRuns(emp)) {
+            if (schedule.getConsecutiveShifts(emp, run.start) != (run.working ? run.length() : 0) ||
+                schedule.getConsecutiveDaysOff(emp, run.start) != (run.working ? 0 : run.length())) {
+                test1 = false;
+            }
+        }
+    }
+    
+    logTest("Run Constraints Delta", test1, 
+            test1 ? "" : "Local run delta or run index disagrees with a full rescan");
+    return test1;
+}
+
+bool TestHardConstraints::testLocalEmployeeDelta() {
+    Instance instance;
+    if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+        logTest("Local Employee Delta", false, "Failed to load test instance");
+        return false;
+    }
+    
+    HardConstraints constraints(instance);
+    Schedule schedule(instance);
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> shift_dis(0, instance.getNumShiftTypes());
+    for (int emp = 0; emp < schedule.getNumEmployees(); emp++) {
+        for (int day = 0; day < schedule.getHorizonDays(); day++) {
+            schedule.setAssignment(emp, day, shift_dis(gen));
+        }
+    }
+    RunIndex runs(schedule);
+    
+    // Random changes: the window-local delta must equal the difference of two
+    // full evaluations of the row; cross-check mode must not throw on them
+    constraints.setDeltaCrossCheck(true);
+    bool test1 = constraints.isDeltaCrossCheckEnabled();
+    std::uniform_int_distribution<> emp_dis(0, schedule.getNumEmployees() - 1);
+    std::uniform_int_distribution<> day_dis(0, schedule.getHorizonDays() - 1);
+    try {
+        for (int step = 0; step < 500 && test1; step++) {
+            int emp = emp_dis(gen);
+            int day = day_dis(gen);
+            int new_shift = shift_dis(gen);
+            
+            int local_delta = constraints.calculateEmployeeDelta(schedule, runs, emp, day, new_shift);
+            int before = constraints.evaluateEmployee(schedule, emp);
+            bool was_working = schedule.getAssignment(emp, day) != 0;
+            schedule.setAssignment(emp, day, new_shift);
+            if (was_working != (new_shift != 0)) {
+                runs.update(emp, day, new_shift != 0);
+            }
+            test1 = (local_delta == constraints.evaluateEmployee(schedule, emp) - before);
+        }
+    } catch (const std::logic_error&) {
+        test1 = false;
+    }
+    
+    logTest("Local Employee Delta", test1,
+            test1 ? "" : "Window-local delta disagrees with a full row evaluation");
+    return test1;
+}
+
 bool TestHardConstraints::testAggregateEvaluation() {
     Instance instance;
     if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
@@ -264,6 +368,8 @@ void TestHardConstraints::runAllTests() {
     testMaxConsecutiveShifts();
     testPreAssignedDaysOff();
     testShiftRotation();
+    testRunConstraintsDelta();
+    testLocalEmployeeDelta();
     testAggregateEvaluation();
     testMoveEvaluation();
     
@@ -25,6 +25,8 @@ public:
     bool testMaxConsecutiveShifts();
     bool testPreAssignedDaysOff();
     bool testShiftRotation();
+    bool testRunConstraintsDelta();
+    bool testLocalEmployeeDelta();
     
     // Aggregate functionality tests
     bool testAggregateEvaluation();
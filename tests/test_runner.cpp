@@ -5,9 +5,25 @@
 #include "../src/core/instance_parser.h"
 #include "../src/core/instance.h"
 #include "../src/core/data_structures.h"
+#include "../src/core/schedule_view.h"
+#include "../src/core/schedule_pool.h"
+#include "../src/core/schedule_archive.h"
+#include "../src/core/instance_cache.h"
+#include "../src/core/schedule_symmetry.h"
+#include "../src/core/candidate_lists.h"
+#include "../src/constraints/incremental_evaluator.h"
+#include "../src/utils/random.h"
+#include "../src/metaheuristics/neighborhood.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <fstream>
 #include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <cstdio>
+#include <cstdlib>
 
 TestRunner::TestRunner() : tests_passed(0), tests_failed(0) {}
 
@@ -64,6 +80,54 @@ bool TestRunner::runParsingTest(const std::string& instance_file) {
     return valid;
 }
 
+bool TestRunner::runMalformedParsingTest() {
+    const std::string path = "test_parser_input.txt";
+    auto parse = [&](const std::string& contents, int& horizon, std::vector<Shift>& shifts, std::vector<Staff>& workers) {
+        std::ofstream(path, std::ios::binary) << contents;
+        InstanceParser parser;
+        std::vector<DaysOff> days_off;
+        std::vector<ShiftOnRequest> on_requests;
+        std::vector<ShiftOffRequest> off_requests;
+        std::vector<Cover> covers;
+        return parser.parseInstance(path, horizon, workers, shifts, days_off, on_requests, off_requests, covers);
+    };
+    
+    bool valid = true;
+    std::string error_msg;
+    int horizon = 0;
+    std::vector<Shift> shifts;
+    std::vector<Staff> workers;
+    
+    // CRLF line endings, a single-digit horizon and multi-letter ids parse cleanly
+    std::string crlf = "SECTION_HORIZON\r\n7\r\n\r\nSECTION_SHIFTS\r\nEarly,480,\r\nLate,480,Early|\r\n\r\n"
+                       "SECTION_STAFF\r\nA,Early=3|Late=None,2400,0,5,1,1,1\r\n";
+    if (!parse(crlf, horizon, shifts, workers) || horizon != 7 || shifts.size() != 2 ||
+        shifts[1].cant_follow != std::vector<std::string>{"Early"} || workers.size() != 1 ||
+        workers[0].MaxShifts != std::vector<std::string>{"3", "None"} || workers[0].MaxTotalMinutes != 2400) {
+        valid = false;
+        error_msg = "Well-formed CRLF input rejected or misread";
+    }
+    
+    // Malformed numbers and missing fields are rejected
+    std::vector<std::string> malformed = {
+        "SECTION_HORIZON\n14x\n",
+        "SECTION_SHIFTS\nE,eight hours,\n",
+        "SECTION_STAFF\nA,E=14,2400,0,5\n",
+        "SECTION_STAFF\nA,E=lots,2400,0,5,1,1,1\n",
+        "SECTION_COVER\n0,E,2,100\n"
+    };
+    for (const auto& contents : malformed) {
+        if (parse(contents, horizon, shifts, workers)) {
+            valid = false;
+            error_msg = "Malformed input accepted: " + contents.substr(0, contents.find('\n', contents.find('\n') + 1));
+        }
+    }
+    std::remove(path.c_str());
+    
+    logTest("Parse Malformed Input", valid, error_msg);
+    return valid;
+}
+
 bool TestRunner::runScheduleTest() {
     // Test Schedule class basic functionality
     Schedule schedule(3, 7, 3);  // 3 employees, 7 days
@@ -273,6 +337,749 @@ bool TestRunner::runAdvancedScheduleTests() {
             test13 ? "" : "Clear operation failed");
     all_tests_passed &= test13;
     
+    // Test 14: Row-major storage views
+    Schedule row_schedule(3, 4, 3);
+    row_schedule.setAssignment(1, 0, 2);
+    row_schedule.setAssignment(1, 3, 3);
+    row_schedule.setAssignment(2, 1, 1);
+    
+    const Schedule::Cell* row = row_schedule.getEmployeeRow(1);
+    Schedule::EmployeeScheduleView view = row_schedule.getEmployeeSchedule(1);
+    bool test14 = (row[0] == 2 && row[3] == 3 && view[0] == 2 && view[3] == 3 &&
+                   view.size() == 4 && view[4] == 0);
+    
+    int** row_matrix = row_schedule.getRawMatrix();
+    Schedule restored_schedule(3, 4, 3);
+    restored_schedule.setFromRawMatrix(row_matrix);
+    for (int i = 0; i < 3; i++) {
+        delete[] row_matrix[i];
+    }
+    delete[] row_matrix;
+    test14 = test14 && (restored_schedule == row_schedule);
+    
+    logTest("Schedule Row-Major Storage", test14, 
+            test14 ? "" : "Row access or raw matrix round trip failed");
+    all_tests_passed &= test14;
+    
+    // Test 15: Incremental coverage stays consistent with the assignments
+    Schedule incremental_schedule(6, 5, 3);
+    incremental_schedule.randomize(3);
+    incremental_schedule.setAssignment(0, 0, 2);
+    incremental_schedule.setAssignment(5, 4, 0);
+    incremental_schedule.swapAssignments(1, 1, 2, 3);
+    incremental_schedule.swapAssignments(3, 2, 4, 2);
+    
+    bool test15 = true;
+    for (int day = 0; day < 5; day++) {
+        std::vector<int> daily = incremental_schedule.getDailyCoverage(day);
+        for (int shift = 0; shift <= 3; shift++) {
+            int expected = 0;
+            for (int emp = 0; emp < 6; emp++) {
+                if (incremental_schedule.getAssignment(emp, day) == shift) expected++;
+            }
+            if (incremental_schedule.getCoverage(day, shift) != expected || daily[shift] != expected) {
+                test15 = false;
+            }
+        }
+    }
+    incremental_schedule.clear();
+    test15 = test15 && (incremental_schedule.getCoverage(2, 0) == 6 && incremental_schedule.getCoverage(2, 1) == 0);
+    
+    logTest("Schedule Incremental Coverage", test15, 
+            test15 ? "" : "Coverage table out of sync with assignments");
+    all_tests_passed &= test15;
+
+    // Test 16: Shift counts and worked minutes follow every mutation
+    std::vector<int> durations = {480, 600, 300};
+    Schedule counted_schedule(4, 7, 3);
+    counted_schedule.randomize(3);
+    counted_schedule.setShiftDurations(durations);
+    counted_schedule.setAssignment(0, 3, 1);
+    counted_schedule.swapAssignments(1, 2, 3, 5);
+    counted_schedule.swapAssignments(2, 0, 2, 6);
+
+    bool test16 = counted_schedule.tracksMinutes();
+    for (int emp = 0; emp < 4; emp++) {
+        int expected_minutes = 0;
+        for (int shift = 0; shift <= 3; shift++) {
+            int expected = 0;
+            for (int day = 0; day < 7; day++) {
+                if (counted_schedule.getAssignment(emp, day) == shift) expected++;
+            }
+            if (counted_schedule.getShiftCount(emp, shift) != expected) test16 = false;
+            if (shift > 0) expected_minutes += expected * durations[shift - 1];
+        }
+        if (counted_schedule.getTotalMinutes(emp) != expected_minutes ||
+            counted_schedule.getTotalMinutes(emp, durations) != expected_minutes) {
+            test16 = false;
+        }
+    }
+    Schedule counted_copy = counted_schedule;
+    counted_copy.clear();
+    test16 = test16 && counted_copy.getTotalMinutes(1) == 0 && counted_copy.getShiftCount(1, 0) == 7;
+
+    logTest("Schedule Incremental Counters", test16,
+            test16 ? "" : "Shift counts or minutes out of sync with assignments");
+    all_tests_passed &= test16;
+
+    // Test 17: Incremental hash matches a schedule rebuilt from the same cells
+    Schedule hashed_schedule(5, 7, 3);
+    hashed_schedule.randomize(3);
+    hashed_schedule.setAssignment(2, 4, 1);
+    hashed_schedule.swapAssignments(0, 1, 3, 6);
+    hashed_schedule.swapAssignments(4, 2, 4, 5);
+
+    Schedule rebuilt_schedule(5, 7, 3);
+    for (int emp = 0; emp < 5; emp++) {
+        for (int day = 0; day < 7; day++) {
+            rebuilt_schedule.setAssignment(emp, day, hashed_schedule.getAssignment(emp, day));
+        }
+    }
+    bool test17 = hashed_schedule.hash() == rebuilt_schedule.hash() && hashed_schedule == rebuilt_schedule;
+
+    int original_shift = rebuilt_schedule.getAssignment(1, 3);
+    rebuilt_schedule.setAssignment(1, 3, (original_shift + 1) % 4);
+    test17 = test17 && hashed_schedule.hash() != rebuilt_schedule.hash() && hashed_schedule != rebuilt_schedule;
+    rebuilt_schedule.setAssignment(1, 3, original_shift);
+    test17 = test17 && hashed_schedule.hash() == rebuilt_schedule.hash();
+    rebuilt_schedule.clear();
+    test17 = test17 && rebuilt_schedule.hash() == Schedule(5, 7, 3).hash();
+
+    logTest("Schedule Incremental Hash", test17,
+            test17 ? "" : "Hash out of sync with assignments");
+    all_tests_passed &= test17;
+
+    // Test 18: A patched view answers like a schedule with the patches applied
+    Schedule view_base(4, 7, 3);
+    view_base.randomize(3);
+    view_base.setShiftDurations(durations);
+    ScheduleView patched_view = view_base;
+    patched_view.setAssignment(0, 2, 3);
+    patched_view.setAssignment(0, 2, 1);  // Re-patching a cell keeps the latest shift
+    patched_view.swapAssignments(1, 4, 3, 6);
+    patched_view.setAssignment(9, 0, 2);  // Out of range, ignored
+
+    Schedule applied = view_base;
+    applied.setAssignment(0, 2, 1);
+    applied.swapAssignments(1, 4, 3, 6);
+
+    bool test18 = patched_view.getNumPatches() == 3;
+    for (int emp = 0; emp < 4; emp++) {
+        for (int day = 0; day < 7; day++) {
+            if (patched_view.getAssignment(emp, day) != applied.getAssignment(emp, day)) test18 = false;
+        }
+        for (int shift = 0; shift <= 3; shift++) {
+            if (patched_view.getShiftCount(emp, shift) != applied.getShiftCount(emp, shift)) test18 = false;
+        }
+        if (patched_view.getTotalMinutes(emp) != applied.getTotalMinutes(emp) ||
+            patched_view.getTotalMinutes(emp, durations) != applied.getTotalMinutes(emp)) {
+            test18 = false;
+        }
+    }
+    for (int day = 0; day < 7; day++) {
+        for (int shift = 0; shift <= 3; shift++) {
+            if (patched_view.getCoverage(day, shift) != applied.getCoverage(day, shift)) test18 = false;
+        }
+    }
+
+    logTest("Schedule View Overlay", test18,
+            test18 ? "" : "Patched view disagrees with the applied schedule");
+    all_tests_passed &= test18;
+
+    // Test 19: Work bitmask spans several words and tracks every mutation
+    Schedule bits_schedule(3, 130, 3);
+    bits_schedule.randomize(3);
+    bits_schedule.setAssignment(0, 63, 2);
+    bits_schedule.setAssignment(0, 64, 0);
+    bits_schedule.swapAssignments(1, 10, 2, 127);
+    Schedule bits_copy = bits_schedule;
+
+    bool test19 = bits_copy.getWorkWords() == 3;
+    for (int emp = 0; emp < 3; emp++) {
+        for (int day = 0; day < 130; day++) {
+            int expected_work = 0;
+            int expected_off = 0;
+            for (int d = day; d < 130 && bits_copy.getAssignment(emp, d) != 0; d++) expected_work++;
+            for (int d = day; d < 130 && bits_copy.getAssignment(emp, d) == 0; d++) expected_off++;
+            if (bits_copy.getConsecutiveShifts(emp, day) != expected_work ||
+                bits_copy.getConsecutiveDaysOff(emp, day) != expected_off) {
+                test19 = false;
+            }
+        }
+        for (int weekend = 5; weekend < 130; weekend += 7) {
+            bool expected = weekend + 1 < 130 &&
+                (bits_copy.getAssignment(emp, weekend) != 0 || bits_copy.getAssignment(emp, weekend + 1) != 0);
+            if (bits_copy.isWorkingWeekend(emp, weekend) != expected) test19 = false;
+        }
+    }
+    bits_copy.clear();
+    test19 = test19 && bits_copy.getConsecutiveDaysOff(2, 0) == 130;
+
+    logTest("Schedule Work Bitmask", test19,
+            test19 ? "" : "Run queries disagree with the assignments");
+    all_tests_passed &= test19;
+
+    // Test 20: Compact cells reject shift ids that do not fit and memory is fully accounted
+    bool test20 = sizeof(Schedule::Cell) == 1;
+    try {
+        Schedule too_many_shifts(2, 7, Schedule::MAX_SHIFT_TYPES + 1);
+        test20 = false;
+    } catch (const std::invalid_argument&) {
+    }
+    Schedule compact_schedule(4, 28, 3);
+    compact_schedule.setAssignment(0, 0, Schedule::MAX_SHIFT_TYPES);
+    test20 = test20 && compact_schedule.getAssignment(0, 0) == Schedule::MAX_SHIFT_TYPES;
+    try {
+        compact_schedule.setAssignment(0, 1, Schedule::MAX_SHIFT_TYPES + 1);
+        test20 = false;
+    } catch (const std::out_of_range&) {
+    }
+    compact_schedule.setShiftDurations(durations);
+    size_t expected_footprint = Schedule::estimateMemoryFootprint(4, 28, 3);
+    test20 = test20 && compact_schedule.getMemoryFootprint() == expected_footprint;
+
+    logTest("Schedule Compact Cells", test20,
+            test20 ? "" : "Cell range checks or memory accounting are wrong");
+    all_tests_passed &= test20;
+
+    // Test 21: Moves transfer buffers and the pool recycles them without allocating
+    bool test21 = false;
+    Instance pool_instance;
+    if (pool_instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+        SchedulePool pool(pool_instance);
+        Schedule seed = pool.acquire();
+        seed.setAssignment(0, 0, 1);
+        uint64_t seed_hash = seed.hash();
+
+        Schedule moved(std::move(seed));
+        test21 = moved.hash() == seed_hash && moved.getAssignment(0, 0) == 1 &&
+                 seed.getNumEmployees() == 0 && seed.getHorizonDays() == 0;
+        pool.release(std::move(moved));
+
+        // A released buffer comes back cleared
+        Schedule source = pool.acquire();
+        test21 = test21 && source.getAssignment(0, 0) == 0 && source.hash() == 0;
+        source.setAssignment(1, 2, 2);
+        pool.reserve(2);
+
+        size_t allocations_before = Schedule::getBufferAllocations();
+        for (int round = 0; round < 10; round++) {
+            Schedule working = pool.acquire(source);
+            Schedule scratch = pool.acquire();
+            test21 = test21 && working == source && scratch.getAssignment(1, 2) == 0;
+            scratch = working;
+            std::swap(working, scratch);
+            pool.release(std::move(scratch));
+            pool.release(std::move(working));
+        }
+        test21 = test21 && Schedule::getBufferAllocations() == allocations_before &&
+                 pool.available() == 2 && pool.getBuffersCreated() == 3;
+    }
+
+    logTest("Schedule Pool Reuse", test21,
+            test21 ? "" : "Move semantics or pool reuse allocated new buffers");
+    all_tests_passed &= test21;
+
+    // Test 22: Binary archive round-trips appended schedules and rejects other instances
+    bool test22 = false;
+    Instance other_instance;
+    if (pool_instance.isValid() && other_instance.loadFromFile("nsp_instancias/instances1_24/Instance2.txt")) {
+        const std::string archive_path = "test_schedule_archive.bin";
+        std::remove(archive_path.c_str());
+
+        Schedule first(pool_instance);
+        first.randomize(pool_instance.getNumShiftTypes());
+        Schedule second(pool_instance);
+        second.setAssignment(0, 0, 1);
+        test22 = ScheduleArchive::append(archive_path, pool_instance, first, -10, -200) &&
+                 ScheduleArchive::append(archive_path, pool_instance, {{&second, 0, -50}, {&first, -10, -200}});
+
+        ScheduleArchive archive;
+        Schedule loaded(pool_instance);
+        test22 = test22 && archive.open(archive_path) && archive.size() == 3 &&
+                 archive.getHeader(1).hard_score == 0 && archive.getHeader(1).soft_score == -50 &&
+                 archive.load(0, pool_instance, loaded) && loaded == first &&
+                 archive.load(1, pool_instance, loaded) && loaded == second &&
+                 archive.load(2, pool_instance, loaded) && loaded == first;
+
+        // A different instance must not accept the records
+        Schedule other_loaded(other_instance);
+        test22 = test22 && !archive.matches(0, other_instance) && !archive.load(0, other_instance, other_loaded);
+
+        // Nor may a copy of the instance that differs only in MaxShifts or in days off
+        const std::string variant_path = "test_archive_variant.txt";
+        std::ifstream original("nsp_instancias/instances1_24/Instance1.txt", std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+        auto loadVariant = [&](const std::string& from, const std::string& to, Instance& variant) {
+            std::string changed = text;
+            size_t at = from.empty() ? std::string::npos : changed.find(from);
+            if (at != std::string::npos) changed.replace(at, from.size(), to);
+            std::ofstream(variant_path, std::ios::binary) << changed;
+            return (from.empty() || at != std::string::npos) && variant.loadFromFile(variant_path);
+        };
+        Instance same_copy;
+        Instance max_shifts_variant;
+        Instance days_off_variant;
+        test22 = test22 && loadVariant("", "", same_copy) && archive.matches(0, same_copy) &&
+                 loadVariant("\nA,D=14,", "\nA,D=13,", max_shifts_variant) && !archive.matches(0, max_shifts_variant) &&
+                 loadVariant("\nA,0\n", "\nA,1\n", days_off_variant) && !archive.matches(0, days_off_variant);
+        std::remove(variant_path.c_str());
+
+        archive.close();
+        std::remove(archive_path.c_str());
+    }
+
+    logTest("Schedule Binary Archive", test22,
+            test22 ? "" : "Archive write, map or load failed");
+    all_tests_passed &= test22;
+
+    // Test 23: Instance cache reproduces the parsed instance and is keyed by the source text
+    bool test23 = false;
+    {
+        const std::string source_path = "test_instance_cache.txt";
+        std::ifstream original("nsp_instancias/instances1_24/Instance2.txt", std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+        std::ofstream(source_path, std::ios::binary) << text;
+
+        uint64_t hash = 0;
+        Instance parsed;
+        Instance cached;
+        test23 = InstanceCache::hashSource(source_path, hash) && parsed.loadWithCache(source_path) &&
+                 InstanceCache::load(InstanceCache::cachePath(source_path, "", hash), hash, cached);
+
+        // Same records and the same compiled tables as a text load
+        const CompiledInstance& a = parsed.getCompiled();
+        const CompiledInstance& b = cached.getCompiled();
+        test23 = test23 && cached.getFingerprint() == parsed.getFingerprint() &&
+                 cached.getNumEmployees() == parsed.getNumEmployees() &&
+                 cached.getShiftOnRequests().size() == parsed.getShiftOnRequests().size() &&
+                 cached.getCoverageRequirements().size() == parsed.getCoverageRequirements().size() &&
+                 cached.getStaffIndex(parsed.getStaff(1).ID) == 1;
+        for (int emp = 0; emp < parsed.getNumEmployees() && test23; emp++) {
+            for (int day = 0; day < parsed.getHorizonDays(); day++) {
+                test23 = test23 && a.isDayOff(emp, day) == b.isDayOff(emp, day);
+                for (int shift = 1; shift <= parsed.getNumShiftTypes(); shift++) {
+                    test23 = test23 && a.getRequestWeights(emp, day)[shift] == b.getRequestWeights(emp, day)[shift] &&
+                             a.getMaxShifts(emp, shift) == b.getMaxShifts(emp, shift) &&
+                             a.getCoverRequirement(day, shift) == b.getCoverRequirement(day, shift) &&
+                             a.isForbiddenTransition(shift, emp % (parsed.getNumShiftTypes() + 1)) ==
+                             b.isForbiddenTransition(shift, emp % (parsed.getNumShiftTypes() + 1));
+                }
+            }
+        }
+
+        // Editing the text invalidates the cache; the next load reparses and rewrites it
+        std::ofstream(source_path, std::ios::binary | std::ios::app) << "# edited\n";
+        uint64_t edited_hash = 0;
+        Instance reloaded;
+        test23 = test23 && InstanceCache::hashSource(source_path, edited_hash) && edited_hash != hash &&
+                 !InstanceCache::load(InstanceCache::cachePath(source_path, "", edited_hash), edited_hash, reloaded) &&
+                 reloaded.loadWithCache(source_path) &&
+                 InstanceCache::load(InstanceCache::cachePath(source_path, "", edited_hash), edited_hash, reloaded);
+
+        // A truncated cache is ignored rather than trusted
+        std::string cache_path = InstanceCache::cachePath(source_path, "", edited_hash);
+        std::ofstream(cache_path, std::ios::binary | std::ios::trunc) << "NSPI";
+        test23 = test23 && !InstanceCache::load(cache_path, edited_hash, reloaded) &&
+                 reloaded.loadWithCache(source_path) && reloaded.getNumEmployees() == parsed.getNumEmployees();
+
+        std::remove(cache_path.c_str());
+        std::remove(source_path.c_str());
+    }
+
+    logTest("Instance Binary Cache", test23,
+            test23 ? "" : "Cached instance differs from the parsed one or a stale cache was used");
+    all_tests_passed &= test23;
+
+    // Test 24: Generated moves never put work on a pre-assigned day off (frozen cell)
+    bool test24 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance2.txt")) {
+            const CompiledInstance& compiled = instance.getCompiled();
+            Schedule schedule(instance);
+            int frozen_cells = 0;
+            for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+                for (int day = 0; day < instance.getHorizonDays(); day++) {
+                    bool frozen = compiled.isDayOff(emp, day);
+                    frozen_cells += frozen ? 1 : 0;
+                    schedule.setAssignment(emp, day, frozen ? 0 : 1 + (emp + day) % instance.getNumShiftTypes());
+                }
+            }
+
+            ConstraintEvaluator evaluator(instance);
+            Neighborhood neighborhood(instance.getNumEmployees(), instance.getHorizonDays(),
+                                      instance.getNumShiftTypes(), evaluator);
+            test24 = frozen_cells > 0;
+            for (int i = 0; i < 5000 && test24; i++) {
+                Move move = neighborhood.getRandomMove(schedule);
+                if (move.type == MoveType::Change || move.type == MoveType::FixShiftRotation) {
+                    test24 = move.shift2 == 0 || !compiled.isDayOff(move.employee1, move.day1);
+                } else if (move.type == MoveType::Swap) {
+                    test24 = (move.shift2 == 0 || !compiled.isDayOff(move.employee1, move.day1)) &&
+                             (move.shift1 == 0 || !compiled.isDayOff(move.employee2, move.day2));
+                } else if (move.type == MoveType::BlockSwap) {
+                    for (int day = move.day1; day <= move.day2 && test24; day++) {
+                        test24 = (schedule.getAssignment(move.employee2, day) == 0 || !compiled.isDayOff(move.employee1, day)) &&
+                                 (schedule.getAssignment(move.employee1, day) == 0 || !compiled.isDayOff(move.employee2, day));
+                    }
+                }
+            }
+
+            // With the mask enforced the constraint is skipped; otherwise it is still scored
+            Schedule violating = schedule;
+            for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+                for (int day = 0; day < instance.getHorizonDays(); day++) {
+                    if (compiled.isDayOff(emp, day)) violating.setAssignment(emp, day, 1);
+                }
+            }
+            test24 = test24 && evaluator.hard_constraints.evaluatePreAssignedDaysOff(violating) < 0;
+            evaluator.setFrozenCellsEnforced(true);
+            test24 = test24 && evaluator.hard_constraints.evaluatePreAssignedDaysOff(violating) == 0;
+            evaluator.setFrozenCellsEnforced(false);
+        }
+    }
+
+    logTest("Frozen Pre-assigned Days Off", test24,
+            test24 ? "" : "A generated move put work on a frozen cell");
+    all_tests_passed &= test24;
+
+    // Test 25: Instance profile agrees with the raw records
+    bool test25 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+            const InstanceProfile& profile = instance.getProfile();
+            int64_t demand = 0;
+            for (const auto& cover : instance.getCoverageRequirements()) demand += cover.Requirement;
+            int frozen = 0;
+            for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+                for (int day = 0; day < instance.getHorizonDays(); day++) {
+                    frozen += instance.getCompiled().isDayOff(emp, day) ? 1 : 0;
+                }
+            }
+            InstanceProfile::SuggestedParameters suggested = profile.suggestParameters();
+            test25 = profile.num_cells == instance.getNumEmployees() * instance.getHorizonDays() &&
+                     profile.demand_assignments == demand && profile.frozen_cells == frozen &&
+                     profile.num_requests == static_cast<int>(instance.getShiftOnRequests().size() +
+                                                              instance.getShiftOffRequests().size()) &&
+                     static_cast<int>(profile.day_tightness.size()) == instance.getHorizonDays() &&
+                     profile.max_day_tightness >= profile.mean_day_tightness &&
+                     profile.demand_capacity_ratio > 0.0 && profile.frozen_share > 0.0 && profile.frozen_share < 1.0 &&
+                     suggested.initial_temp > 0.0 && suggested.stagnation_limit > 0;
+        }
+    }
+
+    logTest("Instance Profile", test25,
+            test25 ? "" : "Profile metrics do not match the instance records");
+    all_tests_passed &= test25;
+
+    // Test 26: Employee equivalence classes, symmetric dedupe and neutral moves
+    bool test26 = false;
+    {
+        // A and B are interchangeable; C has the same contract but a day off and a request
+        const std::string source_path = "test_symmetry_instance.txt";
+        std::ofstream(source_path) << "SECTION_HORIZON\n7\n\n"
+                                   << "SECTION_SHIFTS\nD,480,\n\n"
+                                   << "SECTION_STAFF\nA,D=7,3360,0,5,1,1,2\nB,D=7,3360,0,5,1,1,2\nC,D=7,3360,0,5,1,1,2\n\n"
+                                   << "SECTION_DAYS_OFF\nC,3\n\n"
+                                   << "SECTION_SHIFT_ON_REQUESTS\nC,1,D,2\n\n"
+                                   << "SECTION_COVER\n0,D,1,100,1\n1,D,1,100,1\n2,D,1,100,1\n3,D,1,100,1\n"
+                                   << "4,D,1,100,1\n5,D,1,100,1\n6,D,1,100,1\n";
+        Instance instance;
+        if (instance.loadFromFile(source_path)) {
+            const CompiledInstance& compiled = instance.getCompiled();
+            test26 = compiled.getNumEmployeeClasses() == 2 &&
+                     compiled.getEmployeeClass(0) == 0 && compiled.getEmployeeClass(1) == 0 &&
+                     compiled.getEmployeeClass(2) == 2 && compiled.getContractClass(2) == 0 &&
+                     compiled.getDayPattern(2, 0) == 0 && compiled.getDayPattern(2, 1) != 0 &&
+                     compiled.getDayPattern(2, 3) != compiled.getDayPattern(2, 1);
+
+            // Permuting the rows of A and B is the same state; moving work to C is not
+            Schedule schedule(instance);
+            for (int day = 0; day < 3; day++) schedule.setAssignment(0, day, 1);
+            Schedule permuted(instance);
+            for (int day = 0; day < 3; day++) permuted.setAssignment(1, day, 1);
+            Schedule other(instance);
+            for (int day = 0; day < 3; day++) other.setAssignment(2, day, 1);
+            test26 = test26 && schedule != permuted &&
+                     ScheduleSymmetry::canonicalHash(schedule, compiled) == ScheduleSymmetry::canonicalHash(permuted, compiled) &&
+                     ScheduleSymmetry::equivalent(schedule, permuted, compiled) &&
+                     !ScheduleSymmetry::equivalent(schedule, other, compiled);
+
+            // Neutral moves leave both scores unchanged
+            ConstraintEvaluator evaluator(instance);
+            auto scoresAfter = [&](Schedule copy, const Move& move) {
+                int shift1 = copy.getAssignment(move.employee1, move.day1);
+                int shift2 = copy.getAssignment(move.employee2, move.day2);
+                if (move.type == MoveType::BlockSwap) {
+                    for (int day = move.day1; day < move.day1 + move.block_size; day++) {
+                        copy.swapAssignments(move.employee1, day, move.employee2, day);
+                    }
+                } else {
+                    copy.setAssignment(move.employee1, move.day1, shift2);
+                    copy.setAssignment(move.employee2, move.day2, shift1);
+                }
+                return std::make_pair(evaluator.getHardConstraintViolations(copy), evaluator.getSoftConstraintViolations(copy));
+            };
+            auto before = std::make_pair(evaluator.getHardConstraintViolations(schedule), evaluator.getSoftConstraintViolations(schedule));
+            Move block_swap = {MoveType::BlockSwap, 0, 0, 0, 1, 2, 0, 3};
+            Move partial_swap = {MoveType::Swap, 0, 0, 1, 1, 0, 0, 1};
+            test26 = test26 && ScheduleSymmetry::isNeutralMove(schedule, block_swap, compiled) &&
+                     scoresAfter(schedule, block_swap) == before &&
+                     !ScheduleSymmetry::isNeutralMove(schedule, partial_swap, compiled);
+
+            // Same contract but a request on the exchanged day: not neutral
+            Schedule single(instance);
+            single.setAssignment(0, 1, 1);
+            Move to_requested = {MoveType::Swap, 0, 1, 1, 2, 1, 0, 1};
+            Move to_free = {MoveType::Swap, 0, 1, 1, 1, 1, 0, 1};
+            test26 = test26 && !ScheduleSymmetry::isNeutralMove(single, to_requested, compiled) &&
+                     ScheduleSymmetry::isNeutralMove(single, to_free, compiled);
+        }
+        std::remove(source_path.c_str());
+    }
+
+    logTest("Employee Symmetry", test26,
+            test26 ? "" : "Equivalence classes, symmetric dedupe or neutral move detection is wrong");
+    all_tests_passed &= test26;
+
+    // Test 27: Candidate lists stay equal to a from-scratch check while cells change
+    bool test27 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance12.txt")) {
+            const CompiledInstance& compiled = instance.getCompiled();
+            int employees = instance.getNumEmployees();
+            int days = instance.getHorizonDays();
+            int shifts = instance.getNumShiftTypes();
+            Schedule schedule(instance);
+            for (int emp = 0; emp < employees; emp++) {
+                for (int day = 0; day < days; day++) {
+                    schedule.setAssignment(emp, day, (emp * 7 + day * 3) % (shifts + 1));
+                }
+            }
+            CandidateLists lists(compiled);
+            lists.rebuild(schedule);
+
+            auto matchesScratch = [&]() {
+                for (int emp = 0; emp < employees; emp++) {
+                    for (int day = 0; day < days; day++) {
+                        int prev = day > 0 ? schedule.getAssignment(emp, day - 1) : 0;
+                        int next = day + 1 < days ? schedule.getAssignment(emp, day + 1) : 0;
+                        for (int shift = 1; shift <= shifts; shift++) {
+                            bool legal = !compiled.isDayOff(emp, day) && compiled.getMaxShifts(emp, shift) != 0 &&
+                                         !compiled.isForbiddenTransition(prev, shift) &&
+                                         !compiled.isForbiddenTransition(shift, next);
+                            if (legal != lists.contains(emp, day, shift)) return false;
+                        }
+                    }
+                }
+                return true;
+            };
+
+            test27 = matchesScratch();
+            for (int i = 0; i < 2000 && test27; i++) {
+                int emp = Random::getInt(0, employees - 1);
+                int day = Random::getInt(0, days - 1);
+                schedule.setAssignment(emp, day, Random::getInt(0, shifts));
+                lists.update(schedule, emp, day);
+                int shift = Random::getInt(1, shifts);
+                int sampled = lists.sample(day, shift);
+                test27 = sampled < 0 ? lists.getCandidates(day, shift).empty() : lists.contains(sampled, day, shift);
+            }
+            test27 = test27 && matchesScratch();
+        }
+    }
+
+    logTest("Legal Candidate Lists", test27,
+            test27 ? "" : "Incrementally maintained candidate lists diverged from the schedule");
+    all_tests_passed &= test27;
+
+    // Test 28: Swap and BlockSwap deltas (same row, adjacent days, long blocks) match a full re-evaluation
+    bool test28 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance12.txt")) {
+            int employees = instance.getNumEmployees();
+            int days = instance.getHorizonDays();
+            int shifts = instance.getNumShiftTypes();
+            Schedule schedule(instance);
+            for (int emp = 0; emp < employees; emp++) {
+                for (int day = 0; day < days; day++) {
+                    schedule.setAssignment(emp, day, Random::getInt(0, shifts));
+                }
+            }
+
+            ConstraintEvaluator evaluator(instance);
+            evaluator.setDeltaCrossCheck(true);
+            IncrementalEvaluator incremental(evaluator, schedule);
+            test28 = true;
+            try {
+                for (int i = 0; i < 3000 && test28; i++) {
+                    Move move{};
+                    move.employee1 = Random::getInt(0, employees - 1);
+                    move.day1 = Random::getInt(0, days - 1);
+                    if (i % 2 == 0) {
+                        move.type = MoveType::Swap;
+                        // Every third swap stays on one row, often on the next day
+                        move.employee2 = i % 3 == 0 ? move.employee1 : Random::getInt(0, employees - 1);
+                        move.day2 = i % 4 == 0 ? std::min(move.day1 + 1, days - 1) : Random::getInt(0, days - 1);
+                    } else {
+                        move.type = MoveType::BlockSwap;
+                        move.employee2 = Random::getInt(0, employees - 1);
+                        move.block_size = std::min(Random::getInt(1, 10), days - move.day1);
+                        move.day2 = move.day1 + move.block_size - 1;
+                    }
+
+                    Score hard_delta = incremental.getHardScoreDelta(move);
+                    Score soft_delta = incremental.getSoftScoreDelta(move);
+                    Score hard_before = incremental.getHardScore();
+                    Score soft_before = incremental.getSoftScore();
+                    incremental.applyMove(move);
+                    const Schedule& current = incremental.getCurrentSchedule();
+                    test28 = evaluator.getHardConstraintViolations(current) == hard_before + hard_delta &&
+                             evaluator.getSoftConstraintViolations(current) == soft_before + soft_delta;
+                }
+            } catch (const std::logic_error&) {
+                test28 = false;
+            }
+        }
+    }
+
+    logTest("Compound Move Deltas", test28,
+            test28 ? "" : "Swap or BlockSwap delta differs from a full re-evaluation");
+    all_tests_passed &= test28;
+
+    // Test 29: Per-constraint hard scores follow the schedule and give the weighted score
+    bool test29 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance3.txt")) {
+            int employees = instance.getNumEmployees();
+            int days = instance.getHorizonDays();
+            int shifts = instance.getNumShiftTypes();
+            Schedule schedule(instance);
+            for (int emp = 0; emp < employees; emp++) {
+                for (int day = 0; day < days; day++) {
+                    schedule.setAssignment(emp, day, Random::getInt(0, shifts));
+                }
+            }
+
+            ConstraintEvaluator evaluator(instance);
+            IncrementalEvaluator incremental(evaluator, schedule);
+            Neighborhood neighborhood(employees, days, shifts, evaluator);
+            test29 = true;
+            for (int i = 0; i < 2000 && test29; i++) {
+                Move move = neighborhood.getRandomMove(incremental.getCurrentSchedule());
+                HardScoreVector expected = incremental.getHardScores();
+                expected += incremental.getHardScoreDeltas(move);
+                incremental.applyMove(move);
+                if (i % 100 == 0) {
+                    evaluator.updateDynamicWeights(incremental.getHardScores());
+                }
+
+                const Schedule& current = incremental.getCurrentSchedule();
+                HardScoreVector full = evaluator.hard_constraints.evaluateAllByType(current);
+                test29 = incremental.getHardScores() == expected && expected == full &&
+                         full.total() == evaluator.getHardConstraintViolations(current) &&
+                         evaluator.getWeightedHardScore(full) == evaluator.getWeightedHardConstraintViolations(current);
+            }
+        }
+    }
+
+    logTest("Per-Constraint Hard Scores", test29,
+            test29 ? "" : "Incremental per-constraint scores differ from a full evaluation");
+    all_tests_passed &= test29;
+
+    // Test 30: Weight updates from the per-type scores match updates from a full evaluation
+    bool test30 = false;
+    {
+        Instance instance;
+        if (instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+            Schedule schedule(instance);
+            ConstraintEvaluator from_scores(instance);
+            ConstraintEvaluator from_schedule(instance);
+            HardScoreVector scores = from_scores.hard_constraints.evaluateAllByType(schedule);
+            for (int i = 0; i < 50; i++) {
+                from_scores.updateDynamicWeights(scores);
+                from_schedule.updateDynamicWeights(schedule);
+            }
+            auto weights = from_scores.getDynamicWeights();
+            test30 = weights == from_schedule.getDynamicWeights() &&
+                     from_scores.getViolationCounts() == from_schedule.getViolationCounts() &&
+                     scores[HardConstraintType::WORKING_TIME_CONSTRAINTS] < 0 &&
+                     from_scores.getDynamicWeight(HardConstraintType::WORKING_TIME_CONSTRAINTS) == 10.0 &&
+                     from_scores.getDynamicWeight(HardConstraintType::SHIFT_ROTATION) == 0.1;
+            from_scores.resetDynamicWeights();
+            test30 = test30 && from_scores.getDynamicWeight(HardConstraintType::WORKING_TIME_CONSTRAINTS) == 1.0 &&
+                     from_scores.getViolationCounts().at(HardConstraintType::WORKING_TIME_CONSTRAINTS) == 0;
+        }
+    }
+
+    logTest("Dynamic Weight Updates", test30,
+            test30 ? "" : "Array-backed weight updates disagree with the full-evaluation path");
+    all_tests_passed &= test30;
+
+    // Test 31: Fixed-point weighted scores are exact and lexicographic keys order (hard, soft)
+    bool test31 = ScoreUtils::lexicographicKey(-1, 0) < ScoreUtils::lexicographicKey(0, -1000000) &&
+                  ScoreUtils::lexicographicKey(-2, -5) < ScoreUtils::lexicographicKey(-2, -4) &&
+                  ScoreUtils::lexicographicKey(-3, 7) == ScoreUtils::lexicographicKey(-3, 7);
+    {
+        Instance instance;
+        if (test31 && instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
+            Schedule schedule(instance);
+            ConstraintEvaluator evaluator(instance);
+            HardScoreVector scores = evaluator.hard_constraints.evaluateAllByType(schedule);
+            test31 = evaluator.getWeightedHardScore(scores) == scores.total() * ScoreUtils::WEIGHT_SCALE;
+            for (int i = 0; i < 7; i++) {
+                evaluator.updateDynamicWeights(scores);
+            }
+            Score expected = 0;
+            for (int t = 0; t < NUM_HARD_CONSTRAINT_TYPES; t++) {
+                HardConstraintType type = static_cast<HardConstraintType>(t);
+                expected += scores[type] * std::llround(evaluator.getDynamicWeight(type) * ScoreUtils::WEIGHT_SCALE);
+            }
+            test31 = test31 && evaluator.getWeightedHardScore(scores) == expected &&
+                     evaluator.getWeightedHardConstraintViolations(schedule) == expected;
+        }
+    }
+
+    logTest("Fixed-Point Scores", test31,
+            test31 ? "" : "Weighted scores are not exact or lexicographic keys misorder (hard, soft)");
+    all_tests_passed &= test31;
+
+    // Test 32: RunIndex follows work/off flips without allocating
+    bool test32 = true;
+    {
+        Schedule runs_schedule(6, 150, 3);  // Horizon spans three bitmask words
+        runs_schedule.randomize(3);
+        RunIndex runs(runs_schedule);
+        size_t allocations_before = RunIndex::getBufferAllocations();
+        for (int i = 0; i < 3000 && test32; i++) {
+            int emp = Random::getInt(0, 5);
+            int day = Random::getInt(0, 149);
+            int shift = runs_schedule.getAssignment(emp, day) == 0 ? Random::getInt(1, 3) : 0;
+            runs_schedule.setAssignment(emp, day, shift);
+            runs.update(emp, day, shift != 0);
+
+            int probe = Random::getInt(0, 149);
+            RunIndex::Run run = runs.runContaining(emp, probe);
+            bool working = runs_schedule.getAssignment(emp, probe) != 0;
+            int start = probe;
+            while (start > 0 && (runs_schedule.getAssignment(emp, start - 1) != 0) == working) start--;
+            int end = probe + 1;
+            while (end < 150 && (runs_schedule.getAssignment(emp, end) != 0) == working) end++;
+            test32 = run.start == start && run.end == end && run.working == working;
+        }
+        runs.rebuild(runs_schedule);
+        test32 = test32 && RunIndex::getBufferAllocations() == allocations_before;
+    }
+
+    logTest("Run Index Without Allocation", test32,
+            test32 ? "" : "Run index disagrees with a rescan or allocated while updating");
+    all_tests_passed &= test32;
+
     return all_tests_passed;
 }
 
@@ -331,7 +1138,87 @@ bool TestRunner::runInstanceTest(const std::string& instance_file) {
                 valid = false;
                 error_msg = "Staff index validation failed";
             }
-            
+
+            // Test that the compiled integer view agrees with the string data
+            const CompiledInstance& compiled = instance.getCompiled();
+            for (int emp = 0; emp < instance.getNumEmployees() && valid; emp++) {
+                const Staff& staff = instance.getStaff(emp);
+                const CompiledInstance::EmployeeLimits& limits = compiled.getLimits(emp);
+                bool limits_match = limits.max_total_minutes == staff.MaxTotalMinutes &&
+                                    limits.min_total_minutes == staff.MinTotalMinutes &&
+                                    limits.max_consecutive_shifts == staff.MaxConsecutiveShifts &&
+                                    limits.min_consecutive_shifts == staff.MinConsecutiveShifts &&
+                                    limits.min_consecutive_days_off == staff.MinConsecutiveDaysOff &&
+                                    limits.max_weekends == staff.MaxWeekends;
+                for (size_t i = 0; i < staff.MaxShifts.size() && i < static_cast<size_t>(instance.getNumShiftTypes()); i++) {
+                    int expected = staff.MaxShifts[i] == "None" ? CompiledInstance::NO_LIMIT : std::stoi(staff.MaxShifts[i]);
+                    limits_match = limits_match && compiled.getMaxShifts(emp, static_cast<int>(i) + 1) == expected;
+                }
+                if (!limits_match) {
+                    valid = false;
+                    error_msg = "Compiled limits differ for employee " + staff.ID;
+                }
+            }
+            for (const auto& days_off : instance.getDaysOff()) {
+                int emp = instance.getStaffIndex(days_off.EmployeeID);
+                for (const auto& day : days_off.DayIndexes) {
+                    if (emp >= 0 && !compiled.isDayOff(emp, std::stoi(day))) {
+                        valid = false;
+                        error_msg = "Compiled days off miss day " + day + " of " + days_off.EmployeeID;
+                    }
+                }
+            }
+            // The compiled table holds shift-on plus shift-off weights per cell
+            int shift_slots = instance.getNumShiftTypes() + 1;
+            std::vector<int> expected_weights(static_cast<size_t>(instance.getNumEmployees()) *
+                                              instance.getHorizonDays() * shift_slots, 0);
+            auto addRequest = [&](const std::string& employee_id, int day, const std::string& shift_id, int weight) {
+                int emp = instance.getStaffIndex(employee_id);
+                int shift = instance.getShiftIndex(shift_id) + 1;
+                if (emp >= 0 && shift > 0 && day >= 0 && day < instance.getHorizonDays()) {
+                    expected_weights[(static_cast<size_t>(emp) * instance.getHorizonDays() + day) * shift_slots + shift] += weight;
+                }
+            };
+            for (const auto& request : instance.getShiftOnRequests()) {
+                addRequest(request.EmployeeID, request.Day, request.ShiftID, request.Weight);
+            }
+            for (const auto& request : instance.getShiftOffRequests()) {
+                addRequest(request.EmployeeID, request.Day, request.ShiftID, request.Weight);
+            }
+            for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+                for (int day = 0; day < instance.getHorizonDays(); day++) {
+                    const int* weights = compiled.getRequestWeights(emp, day);
+                    for (int shift = 0; shift < shift_slots; shift++) {
+                        if (weights[shift] != expected_weights[(static_cast<size_t>(emp) * instance.getHorizonDays() + day) * shift_slots + shift]) {
+                            valid = false;
+                            error_msg = "Compiled request weights differ from the shift-on and shift-off requests";
+                        }
+                    }
+                }
+            }
+            for (int prev = 0; prev <= instance.getNumShiftTypes(); prev++) {
+                for (int next = 0; next <= instance.getNumShiftTypes(); next++) {
+                    bool expected = false;
+                    if (prev > 0 && next > 0) {
+                        const auto& cant_follow = instance.getShift(prev - 1).cant_follow;
+                        expected = std::find(cant_follow.begin(), cant_follow.end(),
+                                             instance.getShift(next - 1).ShiftID) != cant_follow.end();
+                    }
+                    if (compiled.isForbiddenTransition(prev, next) != expected) {
+                        valid = false;
+                        error_msg = "Compiled shift transitions differ";
+                    }
+                }
+            }
+            for (const auto& cover : instance.getCoverageRequirements()) {
+                int shift = instance.getShiftIndex(cover.ShiftID) + 1;
+                if (compiled.getCoverRequirement(cover.Day, shift) != cover.Requirement ||
+                    compiled.getCoverWeightUnder(cover.Day, shift) != std::abs(cover.Weight_for_under)) {
+                    valid = false;
+                    error_msg = "Compiled cover differs on day " + std::to_string(cover.Day);
+                }
+            }
+
         } catch (const std::exception& e) {
             valid = false;
             error_msg = "Exception in optimized access: " + std::string(e.what());
@@ -351,6 +1238,7 @@ void TestRunner::runBasicTests() {
     
     // Test parsing with Instance1
     runParsingTest("nsp_instancias/instances1_24/Instance1.txt");
+    runMalformedParsingTest();
     
     // Test new Instance class
     runInstanceTest("nsp_instancias/instances1_24/Instance1.txt");
@@ -20,6 +20,7 @@ public:
     // Test execution methods
     bool runInstanceTest(const std::string& instance_file);
     bool runParsingTest(const std::string& instance_file);
+    bool runMalformedParsingTest();
     bool runScheduleTest();
     bool runAdvancedScheduleTests();
     bool runHardConstraintsTests();
@@ -223,6 +223,97 @@ bool TestSoftConstraints::testEmployeeEvaluation() {
     return all_passed;
 }
 
+bool TestSoftConstraints::testEmployeeDelta() {
+    Instance instance;
+    if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance2.txt")) {
+        logTest("Employee Delta", false, "Failed to load test instance");
+        return false;
+    }
+    
+    SoftConstraints constraints(instance);
+    Schedule schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes());
+    int num_shifts = instance.getNumShiftTypes();
+    for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+        for (int day = 0; day < instance.getHorizonDays(); day++) {
+            schedule.setAssignment(emp, day, (emp + 2 * day) % (num_shifts + 1));
+        }
+    }
+    
+    // The O(1) delta must match re-evaluating the employee for every cell and shift
+    bool all_passed = true;
+    for (int emp = 0; emp < instance.getNumEmployees() && all_passed; emp++) {
+        int base_score = constraints.evaluateEmployee(schedule, emp);
+        for (int day = 0; day < instance.getHorizonDays() && all_passed; day++) {
+            int old_shift = schedule.getAssignment(emp, day);
+            for (int shift = 0; shift <= num_shifts; shift++) {
+                int delta = constraints.calculateEmployeeDelta(schedule, emp, day, shift);
+                schedule.setAssignment(emp, day, shift);
+                int expected = constraints.evaluateEmployee(schedule, emp) - base_score;
+                schedule.setAssignment(emp, day, old_shift);
+                if (delta != expected) {
+                    all_passed = false;
+                    break;
+                }
+            }
+        }
+    }
+    
+    logTest("Employee Delta", all_passed, 
+            all_passed ? "" : "Employee delta differs from re-evaluation");
+    
+    return all_passed;
+}
+
+bool TestSoftConstraints::testCoverageDelta() {
+    Instance instance;
+    if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance2.txt")) {
+        logTest("Coverage Delta", false, "Failed to load test instance");
+        return false;
+    }
+    
+    SoftConstraints constraints(instance);
+    Schedule schedule(instance.getNumEmployees(), instance.getHorizonDays(), instance.getNumShiftTypes());
+    int num_shifts = instance.getNumShiftTypes();
+    for (int emp = 0; emp < instance.getNumEmployees(); emp++) {
+        for (int day = 0; day < instance.getHorizonDays(); day++) {
+            schedule.setAssignment(emp, day, (emp * day + day) % (num_shifts + 1));
+        }
+    }
+    
+    // Employee and coverage deltas together must match a full re-evaluation,
+    // whether the move leaves a shift under-, exactly or over-covered
+    bool all_passed = true;
+    int base_score = constraints.evaluateAll(schedule);
+    for (int emp = 0; emp < instance.getNumEmployees() && all_passed; emp++) {
+        for (int day = 0; day < instance.getHorizonDays() && all_passed; day++) {
+            int old_shift = schedule.getAssignment(emp, day);
+            for (int shift = 0; shift <= num_shifts; shift++) {
+                int delta = constraints.calculateEmployeeDelta(schedule, emp, day, shift) +
+                            constraints.calculateCoverageDelta(schedule, day, old_shift, shift);
+                schedule.setAssignment(emp, day, shift);
+                int expected = constraints.evaluateAll(schedule) - base_score;
+                schedule.setAssignment(emp, day, old_shift);
+                if (delta != expected) {
+                    all_passed = false;
+                    break;
+                }
+            }
+        }
+    }
+    
+    // Direct lookup agrees with the cover list
+    for (const auto& cover : instance.getCoverageRequirements()) {
+        if (instance.getCoverageRequirement(cover.Day, cover.ShiftID) != cover.Requirement) {
+            all_passed = false;
+        }
+    }
+    
+    logTest("Coverage Delta", all_passed, 
+            all_passed ? "" : "Coverage delta differs from re-evaluation");
+    
+    return all_passed;
+}
+
 bool TestSoftConstraints::testDetailedAnalysis() {
     Instance instance;
     if (!instance.loadFromFile("nsp_instancias/instances1_24/Instance1.txt")) {
@@ -336,6 +427,8 @@ void TestSoftConstraints::runAllTests() {
     testAggregateEvaluation();
     testMoveEvaluation();
     testEmployeeEvaluation();
+    testEmployeeDelta();
+    testCoverageDelta();
     testDetailedAnalysis();
     testSatisfactionRates();
     testRequestAnalysis();
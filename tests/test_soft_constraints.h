@@ -28,6 +28,8 @@ public:
     bool testAggregateEvaluation();
     bool testMoveEvaluation();
     bool testEmployeeEvaluation();
+    bool testEmployeeDelta();
+    bool testCoverageDelta();
     
     // Analysis and reporting tests
     bool testDetailedAnalysis();